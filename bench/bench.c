@@ -0,0 +1,541 @@
+// bench/bench.c
+// Owned and created by: pcannon09
+//
+// Synthetic benchmark suite for argx-c.
+// Usage: argxc_bench [--json] [--quick] [--max-options N] [--max-tokens N]
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+
+#ifndef _WIN32
+#	include <sys/resource.h>
+#endif
+
+#include "../inc/Argx.h"
+#include "../inc/macros.h"
+
+// Allocation counters, fed by the linker-wrapped allocator (see CMakeLists.txt)
+static size_t benchAllocCount = 0;
+static size_t benchAllocBytes = 0;
+
+// Set when a check of the suite fails; the exit status reports it
+static bool benchFailed = false;
+
+#ifdef ARGX_BENCH_COUNT_ALLOCS
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size)
+{
+    benchAllocCount++;
+    benchAllocBytes += size;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size)
+{
+    benchAllocCount++;
+    benchAllocBytes += count * size;
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    benchAllocCount++;
+    benchAllocBytes += size;
+    return __real_realloc(ptr, size);
+}
+#endif
+
+typedef struct {
+    bool json;
+    bool first;
+} BenchOutput;
+
+typedef struct {
+    double startNs;
+    size_t allocCount;
+    size_t allocBytes;
+} BenchMark;
+
+static double nowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static long peakRssKb(void)
+{
+#ifndef _WIN32
+    struct rusage usage;
+
+    if (getrusage(RUSAGE_SELF, &usage) == 0) return usage.ru_maxrss;
+#endif
+
+    return -1;
+}
+
+static BenchMark benchStart(void)
+{
+    BenchMark mark = {nowNs(), benchAllocCount, benchAllocBytes};
+    return mark;
+}
+
+static void benchReport(BenchOutput *out, size_t options, size_t tokens, const char *phase,
+        size_t ops, BenchMark mark)
+{
+    double totalNs = nowNs() - mark.startNs;
+    size_t allocs = benchAllocCount - mark.allocCount;
+    size_t bytes = benchAllocBytes - mark.allocBytes;
+    double nsPerOp = ops ? totalNs / (double)ops : totalNs;
+
+    if (out->json)
+	{
+        printf("%s\n  {\"options\": %zu, \"tokens\": %zu, \"phase\": \"%s\", \"ops\": %zu, "
+                "\"total_ns\": %.0f, \"ns_per_op\": %.2f, \"allocs\": %zu, \"alloc_bytes\": %zu, "
+                "\"peak_rss_kb\": %ld}",
+                out->first ? "" : ",", options, tokens, phase, ops, totalNs, nsPerOp, allocs, bytes, peakRssKb());
+    }
+    else
+	{
+        printf("%zu,%zu,%s,%zu,%.0f,%.2f,%zu,%zu,%ld\n",
+                options, tokens, phase, ops, totalNs, nsPerOp, allocs, bytes, peakRssKb());
+    }
+
+    out->first = false;
+    fflush(stdout);
+}
+
+// Every fourth option takes sub-options; every eighth sub-option nests one more level
+static bool optionHasSubs(size_t i)
+{
+    return i % 4 == 0;
+}
+
+// Option `i` (and its sub-options), from `arena` or the C heap when NULL
+static ArgxcOptions makeOption(ArgxcArena *arena, size_t i)
+{
+    char id[32], param[32], sparam[32], info[64];
+
+    snprintf(id, sizeof(id), "opt%zu", i);
+    snprintf(param, sizeof(param), "--opt%zu", i);
+    snprintf(sparam, sizeof(sparam), "-o%zu", i);
+    snprintf(info, sizeof(info), "Synthetic option number %zu", i);
+
+    ArgxcOptions option = argxcCreateOptionIn(arena, id, param, sparam, info, optionHasSubs(i), false);
+
+    if (optionHasSubs(i))
+	{
+        ArgxcOptions fast = argxcCreateOptionIn(arena, "fast", "fast", "f", "Fast mode", i % 8 == 0, false);
+        ArgxcOptions slow = argxcCreateOptionIn(arena, "slow", "slow", "s", "Slow mode", false, false);
+
+        if (i % 8 == 0) argxcAddSubOption(&fast, argxcCreateOptionIn(arena, "deep", "deep", "d", "Nested level", false, false));
+
+        argxcAddSubOption(&option, fast);
+        argxcAddSubOption(&option, slow);
+    }
+
+    return option;
+}
+
+// Valid command line: option names, each followed by a sub-option when required
+static char **makeArgv(size_t tokens, size_t options)
+{
+    char **argv = malloc(tokens * sizeof(char *));
+    if (!argv) return NULL;
+
+    argv[0] = "argxc_bench";
+
+    for (size_t i = 1; i < tokens; i++)
+	{
+        size_t opt = (i * 7919) % options;
+        char buffer[32];
+
+        snprintf(buffer, sizeof(buffer), "--opt%zu", opt);
+        argv[i] = malloc(strlen(buffer) + 1);
+        if (argv[i]) strcpy(argv[i], buffer);
+
+        if (optionHasSubs(opt) && i + 1 < tokens) argv[++i] = "fast";
+    }
+
+    return argv;
+}
+
+static void freeArgv(char **argv, size_t tokens)
+{
+    for (size_t i = 1; i < tokens; i++)
+	{
+        if (strcmp(argv[i], "fast") != 0) free(argv[i]);
+    }
+
+    free(argv);
+}
+
+// The arguments after argv[0] as one command string; some are quoted, which the tokenizer undoes
+static char *makeLine(char **argv, size_t tokens, size_t *length)
+{
+    size_t size = 1;
+    for (size_t i = 1; i < tokens; i++) size += strlen(argv[i]) + 3;
+
+    char *line = malloc(size);
+    if (!line) return NULL;
+
+    char *out = line;
+
+    for (size_t i = 1; i < tokens; i++)
+	{
+        const char *quote = i % 16 == 0 ? "'" : i % 16 == 8 ? "\"" : "";
+        out += sprintf(out, "%s%s%s%s", i > 1 ? " " : "", quote, argv[i], quote);
+    }
+
+    *length = (size_t)(out - line);
+
+    return line;
+}
+
+static bool countAction(void *userData, const char *id, size_t handle, int position, const char *value)
+{
+    (void)id;
+    (void)handle;
+    (void)position;
+    (void)value;
+
+    (*(size_t *)userData)++;
+
+    return true;
+}
+
+static void runCase(BenchOutput *out, size_t options, size_t tokens)
+{
+    char **argv = makeArgv(tokens, options);
+    if (!argv) return;
+
+    BenchMark mark = benchStart();
+    Argxc *argxc = argxcCreate("bench", (int)tokens, argv);
+    benchReport(out, options, tokens, "argxcCreate", tokens, mark);
+
+    if (!argxc)
+	{
+        freeArgv(argv, tokens);
+        return;
+    }
+
+    ArgxcOptions *built = malloc(options * sizeof(ArgxcOptions));
+
+    if (built)
+	{
+        mark = benchStart();
+        for (size_t i = 0; i < options; i++) built[i] = makeOption(NULL, i);
+        benchReport(out, options, tokens, "argxcCreateOption", options, mark);
+
+        mark = benchStart();
+        for (size_t i = 0; i < options; i++) argxcAddOption(argxc, built[i]);
+        benchReport(out, options, tokens, "argxcAddOption", options, mark);
+
+        free(built);
+    }
+
+    // Same options from one arena: the repeated sub-option strings are interned once
+    ArgxcArena *arena = argxcArenaCreate(0);
+
+    if (arena)
+	{
+        mark = benchStart();
+        for (size_t i = 0; i < options; i++) makeOption(arena, i);
+        benchReport(out, options, tokens, "argxcCreateOptionIn", options, mark);
+
+        argxcArenaDestroy(arena);
+    }
+
+    mark = benchStart();
+    argxcParse(argxc);
+    benchReport(out, options, tokens, "argxcParse", tokens, mark);
+
+    size_t lookups = options < 10000 ? options : 10000;
+    size_t found = 0;
+
+    mark = benchStart();
+
+    for (size_t i = 0; i < lookups; i++)
+	{
+        char id[32];
+        snprintf(id, sizeof(id), "opt%zu", (i * 31) % options);
+
+        ArgxcParam param = argxcGetParam(argxc, id);
+        found += param.exists;
+        argxcFreeParam(&param);
+    }
+
+    benchReport(out, options, tokens, "argxcGetParam", lookups, mark);
+
+    // Long-running process: one instance, a new command line per request. Every line
+    // is at most as long as the first parse, so none of them may allocate.
+    size_t resets = 10;
+    size_t resetTokens = 0;
+
+    mark = benchStart();
+
+    for (size_t r = 0; r < resets; r++)
+	{
+        size_t count = r % 2 ? tokens : tokens / 2 + 1;
+
+        argxcReset(argxc, (int)count, argv);
+        found += argxcGetParam(argxc, "opt0").exists;
+        resetTokens += count;
+    }
+
+    benchReport(out, options, tokens, "argxcReset", resetTokens, mark);
+
+#ifdef ARGX_BENCH_COUNT_ALLOCS
+    if (benchAllocCount != mark.allocCount)
+	{
+        fprintf(stderr, "argxc_bench: argxcReset allocated %zu times for %zu options / %zu tokens\n",
+                benchAllocCount - mark.allocCount, options, tokens);
+        benchFailed = true;
+    }
+#endif
+
+    size_t optionsCount = 0;
+    ArgxcOptions *registered = argxcGetOptions(argxc, &optionsCount);
+
+    mark = benchStart();
+    bool valid = argxcCompareArgs(registered, optionsCount, argv, tokens);
+    benchReport(out, options, tokens, "argxcCompareArgs", tokens, mark);
+
+    // Queued jobs: the arguments cut into valid vectors of about ten (a window's first token
+    // stands for argv[0], and none starts on a sub-option), checked on one thread, then on
+    // one thread per CPU
+    size_t vectorsCapacity = tokens / 10 + 1;
+    size_t vectors = 0;
+    char ***argvs = malloc(vectorsCapacity * sizeof(char **));
+    size_t *argvCounts = malloc(vectorsCapacity * sizeof(size_t));
+    ArgxcDiagnostic *diagnostics = malloc(vectorsCapacity * sizeof(ArgxcDiagnostic));
+
+    if (argvs && argvCounts && diagnostics)
+	{
+        for (size_t start = 0; start + 1 < tokens && vectors < vectorsCapacity; start += 10)
+		{
+            if (strcmp(argv[start + 1], "fast") == 0) start++;
+
+            argvs[vectors] = argv + start;
+            argvCounts[vectors++] = tokens - start < 11 ? tokens - start : 11;
+        }
+
+        mark = benchStart();
+        size_t validSerial = argxcDiagnoseBatch(registered, optionsCount, argvs, argvCounts, vectors, 1, diagnostics);
+        benchReport(out, options, tokens, "argxcDiagnoseBatch(1)", tokens, mark);
+
+        mark = benchStart();
+        size_t validParallel = argxcDiagnoseBatch(registered, optionsCount, argvs, argvCounts, vectors, 0, diagnostics);
+        benchReport(out, options, tokens, "argxcDiagnoseBatch(cpus)", tokens, mark);
+
+        valid = valid && validSerial == validParallel;
+    }
+
+    free(argvs);
+    free(argvCounts);
+    free(diagnostics);
+
+    // One command string holding every argument (megabytes for the largest cases): split
+    // it once into fresh buffers, then again into the buffers left by the first call
+    size_t lineLength = 0;
+    char *line = makeLine(argv, tokens, &lineLength);
+
+    if (line)
+	{
+        ArgxcTokens split = {0};
+
+        mark = benchStart();
+        bool tokenized = argxcTokenize(&split, line, lineLength) == ARGX_TOKENIZE_OK;
+        benchReport(out, options, tokens, "argxcTokenize", tokens, mark);
+
+        mark = benchStart();
+        tokenized = argxcTokenize(&split, line, lineLength) == ARGX_TOKENIZE_OK && tokenized;
+        benchReport(out, options, tokens, "argxcTokenizeReuse", tokens, mark);
+
+        valid = valid && tokenized && (size_t)split.argc == tokens - 1;
+        for (size_t i = 1; valid && i < tokens; i++) valid = strcmp(split.argv[i - 1], argv[i]) == 0;
+
+        argxcTokensFree(&split);
+        free(line);
+    }
+
+    // "Did you mean" for a mistyped option: every name is a candidate
+    const char *suggestions[ARGX_SUGGEST_MAX];
+    size_t suggests = 10;
+
+    mark = benchStart();
+
+    for (size_t i = 0; i < suggests; i++)
+        found += argxcSuggest(registered, optionsCount, "--otp1", suggestions, ARGX_SUGGEST_MAX) > 0;
+
+    benchReport(out, options, tokens, "argxcSuggest", suggests * optionsCount * 2, mark);
+
+    mark = benchStart();
+    char *docs = argxcCreateDocs(argxc, ARGX_STYLE_PROFESSIONAL, "Bench", "Synthetic CLI");
+    benchReport(out, options, tokens, "argxcCreateDocs", options, mark);
+    free(docs);
+
+    // Daemon pattern: one frozen spec, a fresh result per command line
+    ArgxcSpec *spec = argxcCompile(argxc);
+    size_t parses = tokens >= 100000 ? 10 : 1000;
+
+    mark = benchStart();
+
+    for (size_t i = 0; spec && i < parses; i++)
+	{
+        ArgxcResult *result = argxcSpecParse(spec, (int)tokens, argv);
+        found += argxcResultParamExists(result, "opt0");
+        argxcResultDestroy(result);
+    }
+
+    benchReport(out, options, tokens, "argxcSpecParse", parses, mark);
+
+    // Build-tool line: every other argument a long source path, longer than any option name,
+    // so it is only scanned for its length, never hashed or looked up
+    enum { PATHS = 1024, PATH_SIZE = 160 };
+    char *paths = malloc(PATHS * PATH_SIZE);
+    char **pathArgv = malloc(tokens * sizeof(char *));
+
+    if (spec && paths && pathArgv)
+	{
+        for (size_t i = 0; i < PATHS; i++)
+		{
+            snprintf(paths + i * PATH_SIZE, PATH_SIZE,
+                    "/home/builder/workspace/argx-c/third_party/generated/sources/module%04zu/"
+                    "implementation/detail/translation_unit_%04zu.c", i % 97, i);
+        }
+
+        for (size_t i = 0; i < tokens; i++) pathArgv[i] = i % 2 ? paths + (i / 2 % PATHS) * PATH_SIZE : argv[i];
+
+        mark = benchStart();
+
+        for (size_t i = 0; i < parses; i++)
+		{
+            ArgxcResult *result = argxcSpecParse(spec, (int)tokens, pathArgv);
+            found += result != NULL;
+            argxcResultDestroy(result);
+        }
+
+        benchReport(out, options, tokens, "argxcSpecParse(paths)", parses, mark);
+    }
+
+    free(pathArgv);
+    free(paths);
+
+    // Matching alone: one index probe per token, without the per-parse result
+    size_t matches = tokens >= 100000 ? 10 : 1000;
+
+    mark = benchStart();
+
+    for (size_t i = 0; spec && i < matches; i++)
+	{
+        for (size_t t = 1; t < tokens; t++) found += argxcSpecResolveAbbrev(spec, argv[t], NULL) == 1;
+    }
+
+    benchReport(out, options, tokens, "argxcSpecResolveAbbrev", matches * (tokens - 1), mark);
+
+    // Handlers on every option: one pass instead of one lookup per option
+    size_t nodes = argxcSpecGetNodesCount(spec);
+    ArgxcActionBinding *actions = spec ? malloc((nodes ? nodes : 1) * sizeof(ArgxcActionBinding)) : NULL;
+    size_t handled = 0;
+
+    if (actions)
+	{
+        for (size_t i = 0; i < nodes; i++)
+		{
+            actions[i].action = countAction;
+            actions[i].userData = &handled;
+        }
+
+        mark = benchStart();
+
+        for (size_t i = 0; i < parses; i++)
+		{
+            ArgxcResult *result = argxcSpecDispatch(spec, (int)tokens, argv, actions);
+            argxcResultDestroy(result);
+        }
+
+        benchReport(out, options, tokens, "argxcSpecDispatch", parses, mark);
+        found += handled > 0;
+        free(actions);
+    }
+
+    // Startup from a cached image: map and check it, no per-option work
+    const char *cachePath = "argxc_bench.spec";
+    size_t loads = 100;
+
+    if (spec && argxcSpecSave(spec, cachePath))
+	{
+        mark = benchStart();
+
+        for (size_t i = 0; i < loads; i++)
+		{
+            ArgxcSpec *loaded = argxcSpecLoad(cachePath);
+            found += argxcSpecGetOptionsCount(loaded) == options;
+            argxcSpecDestroy(loaded);
+        }
+
+        benchReport(out, options, tokens, "argxcSpecLoad", loads, mark);
+        remove(cachePath);
+    }
+
+    argxcSpecDestroy(spec);
+
+    mark = benchStart();
+    argxcDestroy(argxc);
+    benchReport(out, options, tokens, "argxcDestroy", options + tokens, mark);
+
+    if (!valid || found == 0)
+	{
+        fprintf(stderr, "argxc_bench: unexpected result for %zu options / %zu tokens\n", options, tokens);
+        benchFailed = true;
+    }
+
+    freeArgv(argv, tokens);
+}
+
+int main(int argc, char *argv[])
+{
+    BenchOutput out = {false, true};
+    size_t maxOptions = 100000;
+    size_t maxTokens = 1000000;
+
+    for (int i = 1; i < argc; i++)
+	{
+        if (strcmp(argv[i], "--json") == 0) out.json = true;
+        else if (strcmp(argv[i], "--quick") == 0) { maxOptions = 1000; maxTokens = 10000; }
+        else if (strcmp(argv[i], "--max-options") == 0 && i + 1 < argc) maxOptions = strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--max-tokens") == 0 && i + 1 < argc) maxTokens = strtoul(argv[++i], NULL, 10);
+        else
+		{
+            fprintf(stderr, "Usage: %s [--json] [--quick] [--max-options N] [--max-tokens N]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    if (out.json) printf("{\"version\": \"%d.%d.%d\", \"results\": [", ARGX_VERSION_MAJOR, ARGX_VERSION_MINOR, ARGX_VERSION_PATCH);
+    else printf("options,tokens,phase,ops,total_ns,ns_per_op,allocs,alloc_bytes,peak_rss_kb\n");
+
+    static const size_t tokenSizes[] = {10, 1000, 100000, 1000000};
+
+    for (size_t options = 10; options <= maxOptions; options *= 10)
+	{
+        for (size_t t = 0; t < sizeof(tokenSizes) / sizeof(tokenSizes[0]) && tokenSizes[t] <= maxTokens; t++)
+		{
+            runCase(&out, options, tokenSizes[t]);
+        }
+    }
+
+    if (out.json) printf("\n]}\n");
+
+    return benchFailed ? 1 : 0;
+}
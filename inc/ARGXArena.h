@@ -0,0 +1,82 @@
+#pragma once
+
+#include <stddef.h>
+
+#include "types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+	/**
+ 	 * @brief Create a bump allocator that hands out memory from large chunks.
+ 	 *
+ 	 * Memory obtained from an arena is never freed individually; it is all released
+ 	 * at once by argxcArenaDestroy(). Each new chunk doubles in size up to
+ 	 * ARGX_ARENA_MAX_CHUNK, so large CLIs still end up with only a few chunks.
+ 	 *
+ 	 * @param chunkSize Size of the first chunk in bytes (0 selects ARGX_ARENA_DEFAULT_CHUNK).
+ 	 * @return ArgxcArena* The arena, or NULL if memory allocation failed.
+ 	 */
+	ArgxcArena *argxcArenaCreate(size_t chunkSize);
+
+	/**
+ 	 * @brief Release every chunk of the arena, and the arena itself.
+ 	 *
+ 	 * @param arena Pointer to the arena.
+ 	 */
+	void argxcArenaDestroy(ArgxcArena *arena);
+
+	/**
+ 	 * @brief Allocate memory from an arena, or from the C heap when `arena` is NULL.
+ 	 *
+ 	 * @param arena Pointer to the arena (may be NULL).
+ 	 * @param size Number of bytes.
+ 	 * @return void* Pointer to the memory, or NULL if memory allocation failed.
+ 	 */
+	void *argxcArenaAlloc(ArgxcArena *arena, size_t size);
+
+	/**
+ 	 * @brief Allocate zeroed memory from an arena, or from the C heap when `arena` is NULL.
+ 	 */
+	void *argxcArenaCalloc(ArgxcArena *arena, size_t count, size_t size);
+
+	/**
+ 	 * @brief Resize a block obtained from argxcArenaAlloc().
+ 	 *
+ 	 * The most recent allocation of an arena grows in place when the chunk has room;
+ 	 * otherwise the data is moved and the old block is left to the arena.
+ 	 *
+ 	 * @param arena Pointer to the arena (may be NULL to use realloc()).
+ 	 * @param ptr Block to resize (may be NULL).
+ 	 * @param oldSize Current size of the block.
+ 	 * @param newSize Requested size.
+ 	 * @return void* Pointer to the resized block, or NULL if memory allocation failed.
+ 	 */
+	void *argxcArenaRealloc(ArgxcArena *arena, void *ptr, size_t oldSize, size_t newSize);
+
+	/**
+ 	 * @brief Release a block; does nothing for arena memory.
+ 	 */
+	void argxcArenaFree(ArgxcArena *arena, void *ptr);
+
+	/**
+ 	 * @brief Duplicate a string into an arena, or onto the C heap when `arena` is NULL.
+ 	 *
+ 	 * @return char* The copy, or NULL if `str` is NULL or memory allocation failed.
+ 	 */
+	char *argxcArenaStrdup(ArgxcArena *arena, const char *str);
+
+	/**
+ 	 * @brief Get the number of bytes handed out by the arena.
+ 	 */
+	size_t argxcArenaGetUsed(const ArgxcArena *arena);
+
+	/**
+ 	 * @brief Get the number of chunks (heap blocks) owned by the arena.
+ 	 */
+	size_t argxcArenaGetChunkCount(const ArgxcArena *arena);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,417 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "types.h"
+#include "ARGXArena.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+	/**
+ 	 * @brief Compile an option tree into an immutable spec.
+ 	 *
+ 	 * The spec copies every string it needs, so `options` may be freed or modified
+ 	 * afterwards. A spec is never written to once created: any number of threads may
+ 	 * parse against it concurrently without locking.
+ 	 *
+ 	 * @param options Array of top-level options (with their sub-options).
+ 	 * @param optionsCount Number of top-level options.
+ 	 * @param flags ArgxcFlags applied by every parse against the spec.
+ 	 * @return ArgxcSpec* The spec, or NULL if memory allocation failed.
+ 	 */
+	ArgxcSpec *argxcSpecCreate(const ArgxcOptions *options, size_t optionsCount, unsigned int flags);
+
+	/**
+ 	 * @brief Compile an option tree into an immutable spec allocated from an arena.
+ 	 *
+ 	 * @param arena Arena to allocate from (NULL behaves like argxcSpecCreate()).
+ 	 * @param options Array of top-level options (with their sub-options).
+ 	 * @param optionsCount Number of top-level options.
+ 	 * @param flags ArgxcFlags applied by every parse against the spec.
+ 	 * @return ArgxcSpec* The spec, or NULL if memory allocation failed.
+ 	 */
+	ArgxcSpec *argxcSpecCreateIn(ArgxcArena *arena, const ArgxcOptions *options, size_t optionsCount, unsigned int flags);
+
+	/**
+ 	 * @brief Compile a static option table (see ARGXStatic.h) into an immutable spec.
+ 	 *
+ 	 * Table positions are kept as node numbers, so the handles generated with the table
+ 	 * can be passed to the `...At` queries. Top-level options must come first, followed
+ 	 * by sub-options grouped by parent, in the order the parents were declared.
+ 	 *
+ 	 * @param options The table.
+ 	 * @param optionsCount Number of entries of the table.
+ 	 * @param flags ArgxcFlags applied by every parse against the spec.
+ 	 * @return ArgxcSpec* The spec, or NULL if the table is out of order or memory allocation failed.
+ 	 */
+	ArgxcSpec *argxcSpecCreateStatic(const ArgxcStaticOption *options, size_t optionsCount, unsigned int flags);
+
+	/**
+ 	 * @brief Compile a static option table into a spec allocated from an arena.
+ 	 */
+	ArgxcSpec *argxcSpecCreateStaticIn(ArgxcArena *arena, const ArgxcStaticOption *options, size_t optionsCount,
+            unsigned int flags);
+
+	/**
+ 	 * @brief Free a spec; every result parsed against it must be destroyed first.
+ 	 *
+ 	 * @param spec Pointer to the spec.
+ 	 */
+	void argxcSpecDestroy(ArgxcSpec *spec);
+
+	/**
+ 	 * @brief Save the compiled image of a spec to a file.
+ 	 *
+ 	 * The image holds the option tree, its lookup index and a string table, using offsets
+ 	 * only, so argxcSpecLoad() can use it in place. It is tied to ARGX_VERSION_STD and to
+ 	 * the byte order of the host that saved it.
+ 	 *
+ 	 * @param spec Pointer to the spec.
+ 	 * @param path File to write (replaced if it exists).
+ 	 * @return bool true on success; no file is left behind on failure.
+ 	 */
+	bool argxcSpecSave(const ArgxcSpec *spec, const char *path);
+
+	/**
+ 	 * @brief Load a spec saved with argxcSpecSave().
+ 	 *
+ 	 * The file is mapped read-only and used in place: loading allocates only the spec
+ 	 * handle, whatever the number of options. Images written by another ARGX_VERSION_STD,
+ 	 * on a host with another byte order, or damaged, are rejected so a stale cache can
+ 	 * simply be rebuilt.
+ 	 *
+ 	 * @param path File to load.
+ 	 * @return ArgxcSpec* The spec (free it with argxcSpecDestroy()), or NULL if the file
+ 	 *         cannot be read or is not a valid image for this version.
+ 	 */
+	ArgxcSpec *argxcSpecLoad(const char *path);
+
+	/**
+ 	 * @brief Get the compiled image of a spec (what argxcSpecSave() writes).
+ 	 *
+ 	 * @param spec Pointer to the spec.
+ 	 * @param size Output: size of the image in bytes.
+ 	 * @return const void* The image; it stays valid until the spec is destroyed.
+ 	 */
+	const void *argxcSpecGetImage(const ArgxcSpec *spec, size_t *size);
+
+	/**
+ 	 * @brief Use an image from memory in place (e.g., one embedded in the executable).
+ 	 *
+ 	 * The image is checked like with argxcSpecLoad(), then borrowed: it must be 8-byte
+ 	 * aligned and outlive the spec.
+ 	 *
+ 	 * @param data Start of the image.
+ 	 * @param size Size of the image in bytes.
+ 	 * @return ArgxcSpec* The spec, or NULL if the image is not valid for this version.
+ 	 */
+	ArgxcSpec *argxcSpecLoadImage(const void *data, size_t size);
+
+	/**
+ 	 * @brief Get the number of top-level options of a spec.
+ 	 *
+ 	 * @param spec Pointer to the spec.
+ 	 * @return size_t Number of top-level options.
+ 	 */
+	size_t argxcSpecGetOptionsCount(const ArgxcSpec *spec);
+
+	/**
+ 	 * @brief Get the number of options of a spec, sub-options included (the size of an
+ 	 * action table for argxcSpecDispatch()).
+ 	 */
+	size_t argxcSpecGetNodesCount(const ArgxcSpec *spec);
+
+	/**
+ 	 * @brief Get the ArgxcFlags a spec was compiled with.
+ 	 */
+	unsigned int argxcSpecGetFlags(const ArgxcSpec *spec);
+
+	/**
+ 	 * @brief List the option and sub-option names starting with `prefix`, in sorted order.
+ 	 *
+ 	 * Walks the spec's prefix trie, so the cost depends on the prefix and the number of
+ 	 * matches, not on the number of options. Useful for shell completion.
+ 	 *
+ 	 * @param spec Pointer to the spec.
+ 	 * @param prefix Prefix to complete ("" lists every name).
+ 	 * @param names Output: up to `max` names (may be NULL to only count); they point into the spec.
+ 	 * @param max Capacity of `names`.
+ 	 * @return size_t Total number of matching names (may exceed `max`).
+ 	 */
+	size_t argxcSpecComplete(const ArgxcSpec *spec, const char *prefix, const char **names, size_t max);
+
+	/**
+ 	 * @brief List the option and sub-option names closest to a mistyped token ("did you mean").
+ 	 *
+ 	 * Names within about one edit per three characters of `token` (Levenshtein distance) are
+ 	 * kept, closest first. Each distinct name of the spec is compared once, with a
+ 	 * bit-parallel algorithm that handles 64 token characters per step.
+ 	 *
+ 	 * @param spec Pointer to the spec.
+ 	 * @param token Token to match.
+ 	 * @param names Output: up to `max` names (at most ARGX_SUGGEST_MAX); they point into the spec.
+ 	 * @param max Capacity of `names`.
+ 	 * @return size_t Number of names written.
+ 	 */
+	size_t argxcSpecSuggest(const ArgxcSpec *spec, const char *token, const char **names, size_t max);
+
+	/**
+ 	 * @brief Resolve a token the way a parse with ARGX_FLAG_ABBREV does.
+ 	 *
+ 	 * Exact names always win; otherwise a `--name` token may be a prefix of long names.
+ 	 *
+ 	 * @param spec Pointer to the spec.
+ 	 * @param arg Token to resolve.
+ 	 * @param name Output: the full name when the token is unambiguous (may be NULL).
+ 	 * @return int Number of matching names: 0 unknown, 1 resolved, more than 1 ambiguous
+ 	 *         (list them with argxcSpecComplete()).
+ 	 */
+	int argxcSpecResolveAbbrev(const ArgxcSpec *spec, const char *arg, const char **name);
+
+	/**
+ 	 * @brief Parse one command line against a spec.
+ 	 *
+ 	 * Scans the arguments once, up to a `--` (see argxcResultGetEndOfOptions()); the result
+ 	 * needs a single allocation and never copies the spec. `argv` is borrowed and must
+ 	 * outlive the result.
+ 	 *
+ 	 * @param spec Pointer to the spec (not modified).
+ 	 * @param argc Number of command-line arguments.
+ 	 * @param argv Array of command-line argument strings (argv[0] is skipped).
+ 	 * @return ArgxcResult* The result, or NULL if memory allocation failed.
+ 	 */
+	ArgxcResult *argxcSpecParse(const ArgxcSpec *spec, int argc, char *const argv[]);
+
+	/**
+ 	 * @brief Parse one command line against a spec, allocating the result from an arena.
+ 	 */
+	ArgxcResult *argxcSpecParseIn(ArgxcArena *arena, const ArgxcSpec *spec, int argc, char *const argv[]);
+
+	/**
+ 	 * @brief Parse one command line, running actions in argv order (see argxcDispatch()).
+ 	 *
+ 	 * `actions` has one entry per node, indexed by handle: with a static spec, the handles
+ 	 * of ARGX_STATIC_SPEC(). Nothing is allocated besides the result.
+ 	 *
+ 	 * @param spec Pointer to the spec (not modified).
+ 	 * @param argc Number of command-line arguments.
+ 	 * @param argv Array of command-line argument strings (argv[0] is skipped).
+ 	 * @param actions argxcSpecGetNodesCount() entries.
+ 	 * @return ArgxcResult* The result (see argxcResultGetStopPos()), or NULL if memory allocation failed.
+ 	 */
+	ArgxcResult *argxcSpecDispatch(const ArgxcSpec *spec, int argc, char *const argv[], const ArgxcActionBinding *actions);
+
+	/**
+ 	 * @brief Dispatch one command line, allocating the result from an arena.
+ 	 */
+	ArgxcResult *argxcSpecDispatchIn(ArgxcArena *arena, const ArgxcSpec *spec, int argc, char *const argv[],
+            const ArgxcActionBinding *actions);
+
+	/**
+ 	 * @brief Parse another command line into an existing result, reusing its memory.
+ 	 *
+ 	 * Everything the result held is replaced, against the same spec. Nothing is allocated
+ 	 * unless `argc` exceeds every line parsed into it before; like realloc(), the result
+ 	 * may then move.
+ 	 *
+ 	 * @param result Result of argxcSpecParse() / argxcSpecDispatch() (or their arena forms).
+ 	 * @param argc Number of command-line arguments.
+ 	 * @param argv Array of command-line argument strings (argv[0] is skipped).
+ 	 * @param actions Run like argxcSpecDispatch() when not NULL.
+ 	 * @return ArgxcResult* The result, or NULL if memory allocation failed (`result` is then left unchanged).
+ 	 */
+	ArgxcResult *argxcResultReparse(ArgxcResult *result, int argc, char *const argv[], const ArgxcActionBinding *actions);
+
+	/**
+ 	 * @brief Get the argv position where an action stopped the parse, -1 if none did.
+ 	 */
+	int argxcResultGetStopPos(const ArgxcResult *result);
+
+	/**
+ 	 * @brief Get the argv position of the `--` ending the options, -1 if none did.
+ 	 *
+ 	 * The tokens after it are operands: the scan resolves none of them as an option or a command.
+ 	 */
+	int argxcResultGetEndOfOptions(const ArgxcResult *result);
+
+	/**
+ 	 * @brief Free a result.
+ 	 *
+ 	 * @param result Pointer to the result.
+ 	 */
+	void argxcResultDestroy(ArgxcResult *result);
+
+	/**
+ 	 * @brief Get the spec a result was parsed against.
+ 	 */
+	const ArgxcSpec *argxcResultGetSpec(const ArgxcResult *result);
+
+	/**
+ 	 * @brief Get the number of tokens that abbreviated several long options (ARGX_FLAG_ABBREV).
+ 	 */
+	size_t argxcResultGetAmbiguousCount(const ArgxcResult *result);
+
+	/**
+ 	 * @brief Find the next ambiguous abbreviation.
+ 	 *
+ 	 * @param result Pointer to the result.
+ 	 * @param from First argv position to check.
+ 	 * @return int Argv position of the token, or -1 if none is left.
+ 	 */
+	int argxcResultFindAmbiguous(const ArgxcResult *result, int from);
+
+	/**
+ 	 * @brief Get the number of commands on the command path (see argxcGetCommandPath()).
+ 	 */
+	size_t argxcResultGetCommandDepth(const ArgxcResult *result);
+
+	/**
+ 	 * @brief Get the command at a depth of the command path.
+ 	 *
+ 	 * Dispatch on the last one: with a static spec it is a handle of ARGX_STATIC_SPEC().
+ 	 *
+ 	 * @param result Pointer to the result.
+ 	 * @param depth Depth of the command (0 is the outermost).
+ 	 * @return size_t Handle of the command, or (size_t)-1 if `depth` is out of range.
+ 	 */
+	size_t argxcResultGetCommandAt(const ArgxcResult *result, size_t depth);
+
+	/**
+ 	 * @brief Get the argv position of the command at a depth, -1 if `depth` is out of range.
+ 	 */
+	int argxcResultGetCommandPos(const ArgxcResult *result, size_t depth);
+
+	/**
+ 	 * @brief Get the id of the command at a depth, NULL if `depth` is out of range.
+ 	 */
+	const char *argxcResultGetCommandId(const ArgxcResult *result, size_t depth);
+
+	/**
+ 	 * @brief Find the index of a parameter by ID (see argxcFindParam()).
+ 	 *
+ 	 * @param result Pointer to the result.
+ 	 * @param id The identifier of the parameter to find.
+ 	 * @return int Index of the parameter, or -1 if not found.
+ 	 */
+	int argxcResultFindParam(const ArgxcResult *result, const char *id);
+
+	/**
+ 	 * @brief Check if a parameter with the given ID exists (see argxcParamExists()).
+ 	 */
+	bool argxcResultParamExists(const ArgxcResult *result, const char *id);
+
+	/**
+ 	 * @brief Retrieve a parameter by ID (see argxcGetParam()).
+ 	 *
+ 	 * Never allocates and only reads the result, so threads may query one result at once;
+ 	 * for options with more than 64 sub-parameters ArgxcParam::subExistsWide points into
+ 	 * the result and stays valid until it is destroyed or reparsed (argxcResultReparse(),
+ 	 * or the next parse after argxcReset()), either of which may move it.
+ 	 *
+ 	 * @param result Pointer to the result.
+ 	 * @param id The identifier of the parameter to retrieve.
+ 	 * @return ArgxcParam The parameter object.
+ 	 */
+	ArgxcParam argxcResultGetParam(const ArgxcResult *result, const char *id);
+
+	/**
+ 	 * @brief Retrieve a sub-parameter from a given parameter by ID (see argxcGetSubParam()).
+ 	 */
+	bool argxcResultGetSubParam(const ArgxcResult *result, const ArgxcParam *param, const char *id);
+
+	/**
+ 	 * @brief Retrieve a parameter by handle, with no string lookup.
+ 	 *
+ 	 * Handles are the positions generated by ARGX_STATIC_SPEC() (node numbers of a spec
+ 	 * from argxcSpecCreateStatic()). A sub-option exists when it appears after its present
+ 	 * parent, like with argxcResultGetParam().
+ 	 *
+ 	 * @param result Pointer to the result.
+ 	 * @param handle Handle of the option.
+ 	 * @return ArgxcParam The parameter object (not existing for an unknown handle).
+ 	 */
+	ArgxcParam argxcResultGetParamAt(const ArgxcResult *result, size_t handle);
+
+	/**
+ 	 * @brief Check a sub-parameter by handle.
+ 	 *
+ 	 * @return bool true if `handle` is a sub-option of `param` and was given.
+ 	 */
+	bool argxcResultGetSubParamAt(const ArgxcResult *result, const ArgxcParam *param, size_t handle);
+
+	/**
+ 	 * @brief Read the value of an ARGX_VALUE_INT64 option.
+ 	 *
+ 	 * Values are converted once while parsing (locale-independent); getters only read the
+ 	 * stored slot. The last occurrence of an option wins.
+ 	 *
+ 	 * @param result Pointer to the result.
+ 	 * @param id The identifier of the option.
+ 	 * @param value Output: the value, written only when ARGX_VALUE_OK is returned.
+ 	 * @return ArgxcValueStatus ARGX_VALUE_OK, or why no value is available.
+ 	 */
+	ArgxcValueStatus argxcResultGetInt64(const ArgxcResult *result, const char *id, int64_t *value);
+
+	/**
+ 	 * @brief Read the value of an ARGX_VALUE_UINT64 option (see argxcResultGetInt64()).
+ 	 */
+	ArgxcValueStatus argxcResultGetUint64(const ArgxcResult *result, const char *id, uint64_t *value);
+
+	/**
+ 	 * @brief Read the value of an ARGX_VALUE_DOUBLE option (see argxcResultGetInt64()).
+ 	 */
+	ArgxcValueStatus argxcResultGetDouble(const ArgxcResult *result, const char *id, double *value);
+
+	/**
+ 	 * @brief Read the value of an ARGX_VALUE_BOOL option (see argxcResultGetInt64()).
+ 	 */
+	ArgxcValueStatus argxcResultGetBool(const ArgxcResult *result, const char *id, bool *value);
+
+	/**
+ 	 * @brief Read the value of an ARGX_VALUE_STRING option (see argxcResultGetInt64()).
+ 	 *
+ 	 * The string is not copied: it points into the parsed argv.
+ 	 */
+	ArgxcValueStatus argxcResultGetString(const ArgxcResult *result, const char *id, const char **value);
+
+	/**
+ 	 * @brief Read the value of an ARGX_VALUE_ENUM option: the position of the chosen sub-option.
+ 	 */
+	ArgxcValueStatus argxcResultGetEnum(const ArgxcResult *result, const char *id, size_t *value);
+
+	/**
+ 	 * @brief Read the value of an ARGX_VALUE_INT64 option by handle (see argxcResultGetInt64()).
+ 	 */
+	ArgxcValueStatus argxcResultGetInt64At(const ArgxcResult *result, size_t handle, int64_t *value);
+
+	/**
+ 	 * @brief Read the value of an ARGX_VALUE_UINT64 option by handle.
+ 	 */
+	ArgxcValueStatus argxcResultGetUint64At(const ArgxcResult *result, size_t handle, uint64_t *value);
+
+	/**
+ 	 * @brief Read the value of an ARGX_VALUE_DOUBLE option by handle.
+ 	 */
+	ArgxcValueStatus argxcResultGetDoubleAt(const ArgxcResult *result, size_t handle, double *value);
+
+	/**
+ 	 * @brief Read the value of an ARGX_VALUE_BOOL option by handle.
+ 	 */
+	ArgxcValueStatus argxcResultGetBoolAt(const ArgxcResult *result, size_t handle, bool *value);
+
+	/**
+ 	 * @brief Read the value of an ARGX_VALUE_STRING option by handle.
+ 	 */
+	ArgxcValueStatus argxcResultGetStringAt(const ArgxcResult *result, size_t handle, const char **value);
+
+	/**
+ 	 * @brief Read the value of an ARGX_VALUE_ENUM option by handle.
+ 	 */
+	ArgxcValueStatus argxcResultGetEnumAt(const ArgxcResult *result, size_t handle, size_t *value);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "types.h"
+#include "ARGXSpec.h"
+
+/*
+ * Static option tables, declared once as an X-macro list:
+ *
+ *     #define MY_CLI(OPTION, SUB) \
+ *         OPTION(CLI_HELP, "help", "--help", "-h", "Show help", true, false, ARGX_VALUE_NONE) \
+ *         OPTION(CLI_JOBS, "jobs", "--jobs", "-j", "Parallel jobs", false, false, ARGX_VALUE_INT64) \
+ *         SUB(CLI_HELP, CLI_HELP_STYLE, "style", "style", NULL, "Help on styles", false, false, ARGX_VALUE_NONE)
+ *
+ *     ARGX_STATIC_SPEC(Cli, MY_CLI)
+ *
+ * expands to `enum CliHandle { CLI_HELP, CLI_JOBS, CLI_HELP_STYLE, CliCount }` and to a
+ * `static const ArgxcStaticOption CliOptions[]` table in the same order, so nothing is built
+ * at startup. Compile it with argxcSpecCreateStatic(CliOptions, CliCount, flags), then query by
+ * handle: argxcResultGetParamAt(result, CLI_HELP) is a plain array access.
+ *
+ * OPTION(handle, id, param, sparam, info, hasSubParams, hasAnySubParams, valueType)
+ * SUB(parent, handle, id, param, sparam, info, hasSubParams, hasAnySubParams, valueType)
+ *
+ * List every OPTION first, then the SUB entries grouped by parent, in the order the parents
+ * were declared (sub-options may themselves be parents of later SUB entries).
+ */
+
+#define ARGX_STATIC_HANDLE_OPTION(handle, ...) handle,
+#define ARGX_STATIC_HANDLE_SUB(parent, handle, ...) handle,
+
+#define ARGX_STATIC_ENTRY_OPTION(handle, id, param, sparam, info, hasSubParams, hasAnySubParams, valueType) \
+    {id, param, sparam, info, -1, hasSubParams, hasAnySubParams, valueType},
+#define ARGX_STATIC_ENTRY_SUB(parent, handle, id, param, sparam, info, hasSubParams, hasAnySubParams, valueType) \
+    {id, param, sparam, info, parent, hasSubParams, hasAnySubParams, valueType},
+
+// Enum of handles and table of a static option list
+#define ARGX_STATIC_SPEC(name, LIST) \
+    enum name##Handle { LIST(ARGX_STATIC_HANDLE_OPTION, ARGX_STATIC_HANDLE_SUB) name##Count }; \
+    static const ArgxcStaticOption name##Options[] = { LIST(ARGX_STATIC_ENTRY_OPTION, ARGX_STATIC_ENTRY_SUB) };
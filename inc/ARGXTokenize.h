@@ -0,0 +1,39 @@
+#pragma once
+
+#include <stddef.h>
+
+#include "types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+	/**
+ 	 * @brief Split a command line into arguments with POSIX shell quoting.
+ 	 *
+ 	 * Blanks (space, tab, newline) separate arguments; '...' keeps everything literally,
+ 	 * "..." lets `\` escape only `$`, `` ` ``, `"`, `\` and newline, and an unquoted `\`
+ 	 * escapes the next character (`\` + newline continues the line). An unquoted `#`
+ 	 * starting an argument comments out the rest of the line. Nothing is expanded:
+ 	 * `$VAR`, globs and redirections are ordinary characters.
+ 	 *
+ 	 * The line is read once, unquoting straight into `tokens->buffer`, so every argument
+ 	 * shares one buffer of `len + 1` bytes; the argv array grows geometrically. Both are
+ 	 * reused by later calls, so a daemon tokenizing a line per request stops allocating once
+ 	 * its longest line has been seen.
+ 	 *
+ 	 * @param tokens Zero-initialized, or filled by a previous call (its arguments are replaced).
+ 	 * @param line Command line; it may contain NUL bytes, which separate arguments.
+ 	 * @param len Length of `line` in bytes.
+ 	 * @return ArgxcTokenizeStatus ARGX_TOKENIZE_OK, or why `tokens` is left empty.
+ 	 */
+	ArgxcTokenizeStatus argxcTokenize(ArgxcTokens *tokens, const char *line, size_t len);
+
+	/**
+ 	 * @brief Free the buffers of a tokenized line and zero it; it may be reused afterwards.
+ 	 */
+	void argxcTokensFree(ArgxcTokens *tokens);
+
+#ifdef __cplusplus
+}
+#endif
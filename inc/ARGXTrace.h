@@ -0,0 +1,62 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include "types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+	/**
+ 	 * @brief Start recording begin/end events of the parser phases (create, tokenizing, option registration,
+ 	 * parse, lookups, argxcCompareArgs, docs) into a ring buffer.
+ 	 *
+ 	 * The buffer is allocated here, once; recording an event takes one atomic increment and
+ 	 * never allocates or locks, so any thread may record. When the buffer is full the oldest
+ 	 * events are overwritten. Starting again discards the recorded events.
+ 	 * Tracing is process-wide and only available when the library is built with ARGX_TRACE.
+ 	 *
+ 	 * @param capacity Number of events kept (0 selects ARGX_TRACE_DEFAULT_CAPACITY; rounded up to a power of two).
+ 	 * @return bool true if tracing started, false if it is compiled out or memory allocation failed.
+ 	 */
+	bool argxcTraceStart(size_t capacity);
+
+	/**
+ 	 * @brief Stop recording; the recorded events are kept for argxcTraceWrite().
+ 	 */
+	void argxcTraceStop(void);
+
+	/**
+ 	 * @brief Write the recorded events, oldest first, as Chrome trace-event JSON
+ 	 * (`{"traceEvents":[...]}`, loadable in chrome://tracing and Perfetto).
+ 	 *
+ 	 * Timestamps are microseconds of the monotonic clock (CLOCK_MONOTONIC, or
+ 	 * QueryPerformanceCounter on Windows) and `pid` / `tid` are the OS ids, so the events
+ 	 * line up with other traces of the process. May run while other threads record;
+ 	 * events overwritten during the write are skipped.
+ 	 *
+ 	 * @param sink Callback receiving the output in pieces.
+ 	 * @param userData Passed unchanged to `sink`.
+ 	 * @return bool true on success, false if tracing is compiled out or `sink` returned false.
+ 	 */
+	bool argxcTraceWrite(ArgxcDocsSink sink, void *userData);
+
+	/**
+ 	 * @brief Write the recorded events as Chrome trace-event JSON to a FILE.
+ 	 */
+	bool argxcTraceWriteToFile(FILE *file);
+
+	/**
+ 	 * @brief Stop recording and free the ring buffer.
+ 	 *
+ 	 * Unlike the other calls, this one (and argxcTraceStart()) must not run while
+ 	 * other threads are inside the library.
+ 	 */
+	void argxcTraceRelease(void);
+
+#ifdef __cplusplus
+}
+#endif
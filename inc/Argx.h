@@ -1,8 +1,14 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stdio.h>
 
 #include "types.h"
+#include "ARGXArena.h"
+#include "ARGXSpec.h"
+#include "ARGXStatic.h"
+#include "ARGXTokenize.h"
+#include "ARGXTrace.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -18,6 +24,70 @@ extern "C" {
  	 */
 	Argxc* argxcCreate(const char *id, int argc, char *argv[]);
 
+	/**
+ 	 * @brief Create a new Argxc instance that borrows the caller's argv instead of copying it.
+ 	 *
+ 	 * No argument string (nor the argv array itself) is copied. Lifetime contract:
+ 	 * `argv` and every string it points to must stay valid and unmodified until
+ 	 * argxcDestroy() is called on the instance. The `argv` received by main() always
+ 	 * satisfies this. argxcDestroy() never frees borrowed arguments.
+ 	 *
+ 	 * @param id Identifier for the parser instance.
+ 	 * @param argc Number of command-line arguments.
+ 	 * @param argv Array of command-line argument strings (borrowed).
+ 	 * @return Argxc* Pointer to the created Argxc instance, or NULL on failure.
+ 	 */
+	Argxc* argxcCreateBorrowed(const char *id, int argc, char *argv[]);
+
+	/**
+ 	 * @brief Create a new Argxc instance whose memory comes from a private arena.
+ 	 *
+ 	 * The ID, argument copies, option array, compiled spec and parse result
+ 	 * are bump-allocated from a few large chunks, and argxcDestroy() releases them
+ 	 * in one step. Create options with argxcCreateOptionIn(argxcGetArena(argxc), ...) so
+ 	 * their strings and sub-option arrays share the arena.
+ 	 *
+ 	 * @param id Identifier for the parser instance.
+ 	 * @param argc Number of command-line arguments.
+ 	 * @param argv Array of command-line argument strings.
+ 	 * @return Argxc* Pointer to the created Argxc instance, or NULL on failure.
+ 	 */
+	Argxc* argxcCreateWithArena(const char *id, int argc, char *argv[]);
+
+	/**
+ 	 * @brief Create a new Argxc instance, expanding `@file` arguments into the file's contents.
+ 	 *
+ 	 * Each `@path` argument (except argv[0]) is replaced by the tokens of the file: separated by
+ 	 * whitespace, with '...' / "..." quoting and backslash escapes, or separated by NUL bytes
+ 	 * when the file contains any (e.g., `find -print0` output). Files may reference other
+ 	 * response files. An `@path` that cannot be opened stays a literal argument.
+ 	 *
+ 	 * Files are memory-mapped and split in place, so tokens are not copied; the mappings stay
+ 	 * alive until argxcDestroy(). The remaining arguments are borrowed from `argv` under the
+ 	 * same contract as argxcCreateBorrowed().
+ 	 *
+ 	 * @param id Identifier for the parser instance.
+ 	 * @param argc Number of command-line arguments.
+ 	 * @param argv Array of command-line argument strings (borrowed).
+ 	 * @param maxDepth Maximum nesting of response files (<= 0 uses ARGX_RESPONSE_MAX_DEPTH).
+ 	 * @return Argxc* Pointer to the created Argxc instance, or NULL on failure or when the nesting exceeds `maxDepth`.
+ 	 */
+	Argxc* argxcCreateWithResponseFiles(const char *id, int argc, char *argv[], int maxDepth);
+
+	/**
+ 	 * @brief Create a new Argxc instance from a command string (e.g., a REPL line or a config value).
+ 	 *
+ 	 * The string is split by argxcTokenize() into one buffer owned by the instance; the
+ 	 * arguments are parsed straight from it, without a copy per argument. `id` becomes
+ 	 * argv[0], so every token of `line` is an argument. Only an unquoted `--` ends the
+ 	 * options; `'--'` is an ordinary argument.
+ 	 *
+ 	 * @param id Identifier for the parser instance.
+ 	 * @param line NUL-terminated command string.
+ 	 * @return Argxc* Pointer to the created Argxc instance, or NULL on failure or when `line` ends inside quotes.
+ 	 */
+	Argxc* argxcCreateFromString(const char *id, const char *line);
+
 	/**
  	 * @brief Create a new Argxc instance with default values (empty ID and no arguments).
  	 *
@@ -48,24 +118,166 @@ extern "C" {
  	 */
 	void argxcAddSubOption(ArgxcOptions *parent, ArgxcOptions subOption);
 
+	/**
+ 	 * @brief Set the parsing behaviour of an instance.
+ 	 *
+ 	 * @param argxc Pointer to the Argxc instance.
+ 	 * @param flags ArgxcFlags combined with `|` (e.g., ARGX_FLAG_ABBREV).
+ 	 */
+	void argxcSetFlags(Argxc *argxc, unsigned int flags);
+
+	/**
+ 	 * @brief Get the parsing behaviour of an instance.
+ 	 *
+ 	 * @param argxc Pointer to the Argxc instance.
+ 	 * @return unsigned int ArgxcFlags of the instance.
+ 	 */
+	unsigned int argxcGetFlags(Argxc *argxc);
+
+	/**
+ 	 * @brief Get the work done so far by an instance.
+ 	 *
+ 	 * Covers argxcCreate* (including response file expansion), parses, argxcGetParam /
+ 	 * argxcFindParam / argxcGetSubParam and argxcCreateDocs. argxcCompareArgs() takes no
+ 	 * instance: it is counted against the latest instance created on the calling thread, and
+ 	 * against none once that instance is destroyed (on any thread).
+ 	 * Statistics are only collected when the library is built with ARGX_STATS
+ 	 * (`-DARGX_ENABLE_STATS=ON`); otherwise every counter compiles to nothing.
+ 	 *
+ 	 * @param argxc Pointer to the Argxc instance.
+ 	 * @param stats Output: the counters (zeroed when statistics are disabled).
+ 	 * @return bool true if statistics are collected, false if they are compiled out.
+ 	 */
+	bool argxcGetStats(const Argxc *argxc, ArgxcStats *stats);
+
+	/**
+ 	 * @brief Reset the statistics of an instance (e.g., to measure one phase).
+ 	 *
+ 	 * @param argxc Pointer to the Argxc instance.
+ 	 */
+	void argxcResetStats(Argxc *argxc);
+
+	/**
+ 	 * @brief Parse the command-line arguments against the registered options.
+ 	 *
+ 	 * Compiles the options into an ArgxcSpec and scans the arguments once against it,
+ 	 * storing the position of every option and sub-option in an ArgxcResult, so later
+ 	 * lookups do not rescan the arguments. Single-character short options may be clustered
+ 	 * POSIX-style (`-abc` is `-a -b -c`); in `-j8` or `-ofile` the first option taking
+ 	 * sub-parameters ends the cluster and the rest of the token is its value. The arguments
+ 	 * after `--` are operands, never matched as options.
+ 	 * The getters call this automatically when the table is missing or stale
+ 	 * (e.g., after argxcAddOption()); sub-options added through the pointer returned by
+ 	 * argxcGetOptions() require an explicit call.
+ 	 *
+ 	 * @param argxc Pointer to the Argxc instance.
+ 	 * @return true on success, false if the instance is NULL or memory allocation failed.
+ 	 */
+	bool argxcParse(Argxc *argxc);
+
+	/**
+ 	 * @brief Replace the command-line arguments, keeping the registered options.
+ 	 *
+ 	 * For a process handling many commands with one instance: the options, their compiled
+ 	 * spec and the parse result stay, and the next parse (explicit or through a getter)
+ 	 * rescans `argv` into the same memory. Once a command at least as long has been parsed,
+ 	 * resetting and parsing again allocates nothing. Memory backing the previous arguments
+ 	 * (copies, response files, a tokenized string) is freed.
+ 	 * Options changed through the pointer returned by argxcGetOptions() are only compiled
+ 	 * by an argxcParse() before the reset.
+ 	 *
+ 	 * @param argxc Pointer to the Argxc instance.
+ 	 * @param argc Number of command-line arguments.
+ 	 * @param argv Array of command-line argument strings (borrowed: it must outlive the
+ 	 * instance or the next reset, and must not change meanwhile).
+ 	 * @return bool true on success, false if the instance is NULL or `argv` is missing.
+ 	 */
+	bool argxcReset(Argxc *argxc, int argc, char *argv[]);
+
+	/**
+ 	 * @brief Parse like argxcParse(), running the action of each option as it is resolved.
+ 	 *
+ 	 * Actions (see argxcSetOptionAction()) run in argv order during the single scan, so a
+ 	 * program handles every option without one lookup per option. A name is resolved
+ 	 * against the sub-options of the last option with sub-options given, then the commands
+ 	 * (see argxcGetCommandPath()), then the top-level options. The getters keep working on
+ 	 * the result; when an action stops the parse, they only see the arguments before it.
+ 	 *
+ 	 * @param argxc Pointer to the Argxc instance.
+ 	 * @return true if every argument was handled, false if an action stopped the parse
+ 	 * (see argxcResultGetStopPos()), the instance is NULL or memory allocation failed.
+ 	 */
+	bool argxcDispatch(Argxc *argxc);
+
+	/**
+ 	 * @brief Freeze the options registered so far into a standalone, shareable spec.
+ 	 *
+ 	 * The spec does not reference the instance, so it may outlive it and be used from
+ 	 * any number of threads with argxcSpecParse(). Free it with argxcSpecDestroy().
+ 	 *
+ 	 * @param argxc Pointer to the Argxc instance.
+ 	 * @return ArgxcSpec* The spec, or NULL if memory allocation failed.
+ 	 */
+	ArgxcSpec *argxcCompile(Argxc *argxc);
+
+	/**
+ 	 * @brief Get the spec the instance parses with (e.g., for argxcSpecComplete()).
+ 	 *
+ 	 * @param argxc Pointer to the Argxc instance.
+ 	 * @return const ArgxcSpec* The spec, owned by the instance and valid until options or
+ 	 *         flags change; NULL on failure.
+ 	 */
+	const ArgxcSpec *argxcGetSpec(Argxc *argxc);
+
+	/**
+ 	 * @brief Get the parse result of the instance (e.g., for argxcResultFindAmbiguous()).
+ 	 *
+ 	 * @param argxc Pointer to the Argxc instance.
+ 	 * @return const ArgxcResult* The result, owned by the instance; NULL on failure.
+ 	 */
+	const ArgxcResult *argxcGetResult(Argxc *argxc);
+
 	/**
  	 * @brief Find the index of a parameter by ID.
  	 *
+ 	 * Like argxcGetParam(), ids are first resolved along the command path.
+ 	 *
  	 * @param argxc Pointer to the Argxc instance.
  	 * @param id The identifier of the parameter to find.
- 	 * @return int Index of the parameter, or -1 if not found.
+ 	 * @return int Index of the parameter (among its siblings for a sub-option), or -1 if not found.
  	 */
 	int argxcFindParam(Argxc *argxc, const char *id);
 
 	/**
  	 * @brief Retrieve a parameter by ID.
  	 *
+ 	 * Never allocates: sub-parameter presence is returned as a bitset (see ArgxcParam).
+ 	 * Bits of options with more than 64 sub-parameters live in the instance and stay valid
+ 	 * until the next parse. Ids are first resolved along the command path (see
+ 	 * argxcGetCommandPath()), so sub-commands at any depth are found.
+ 	 *
  	 * @param argxc Pointer to the Argxc instance.
  	 * @param id The identifier of the parameter to retrieve.
  	 * @return ArgxcParam The parameter object.
  	 */
 	ArgxcParam argxcGetParam(Argxc *argxc, const char *id);
 
+	/**
+ 	 * @brief Get the command path of the command line (e.g., `cluster node drain` in
+ 	 * `tool cluster node drain --force`).
+ 	 *
+ 	 * Words (arguments not starting with `-`) walk the option tree while parsing: a word
+ 	 * naming a child of the last command (or a top-level option, for the first one) becomes
+ 	 * the next command; other words are left as they are. Options of any depth can be
+ 	 * commands, so git-style trees need no extra declaration.
+ 	 *
+ 	 * @param argxc Pointer to the Argxc instance.
+ 	 * @param ids Output: ids of the commands, outermost first (may be NULL).
+ 	 * @param max Capacity of `ids`.
+ 	 * @return size_t Depth of the path (may exceed `max`).
+ 	 */
+	size_t argxcGetCommandPath(Argxc *argxc, const char **ids, size_t max);
+
 	/**
  	 * @brief Check if a parameter with the given ID exists.
  	 *
@@ -78,6 +290,8 @@ extern "C" {
 	/**
  	 * @brief Retrieve a sub-parameter from a given parameter by ID.
  	 *
+ 	 * `id` is resolved among the children of `param` only, then its presence bit is tested.
+ 	 *
  	 * @param argxc Pointer to the Argxc instance.
  	 * @param param Pointer to the parent parameter.
  	 * @param id The identifier of the sub-parameter.
@@ -85,9 +299,82 @@ extern "C" {
  	 */
 	bool argxcGetSubParam(Argxc *argxc, const ArgxcParam *param, const char *id);
 
+	/**
+ 	 * @brief Declare the type of the value an option takes.
+ 	 *
+ 	 * Typed options accept `--opt=value` and `--opt value` (and `-o value`, `-ovalue`).
+ 	 * The value is converted once while parsing; read it with the typed getters below.
+ 	 * For ARGX_VALUE_ENUM the value must name one of the option's sub-options.
+ 	 *
+ 	 * @param option Pointer to the option (before it is added).
+ 	 * @param type Type of the value.
+ 	 */
+	void argxcSetOptionValueType(ArgxcOptions *option, ArgxcValueType type);
+
+	/**
+ 	 * @brief Attach a handler to an option, run by argxcDispatch() each time it is given.
+ 	 *
+ 	 * @param option Pointer to the option (before it is added).
+ 	 * @param action The handler (NULL removes it).
+ 	 * @param userData Passed unchanged to the handler.
+ 	 */
+	void argxcSetOptionAction(ArgxcOptions *option, ArgxcAction action, void *userData);
+
+	/**
+ 	 * @brief Read the value of an ARGX_VALUE_INT64 option.
+ 	 *
+ 	 * No re-scanning and no copies: the value was converted (locale-independently) by the parse.
+ 	 *
+ 	 * @param argxc Pointer to the Argxc instance.
+ 	 * @param id The identifier of the option.
+ 	 * @param value Output: the value, written only when ARGX_VALUE_OK is returned.
+ 	 * @return ArgxcValueStatus ARGX_VALUE_OK, or why no value is available.
+ 	 */
+	ArgxcValueStatus argxcGetInt64(Argxc *argxc, const char *id, int64_t *value);
+
+	/**
+ 	 * @brief Read the value of an ARGX_VALUE_UINT64 option (see argxcGetInt64()).
+ 	 */
+	ArgxcValueStatus argxcGetUint64(Argxc *argxc, const char *id, uint64_t *value);
+
+	/**
+ 	 * @brief Read the value of an ARGX_VALUE_DOUBLE option (see argxcGetInt64()).
+ 	 */
+	ArgxcValueStatus argxcGetDouble(Argxc *argxc, const char *id, double *value);
+
+	/**
+ 	 * @brief Read the value of an ARGX_VALUE_BOOL option (see argxcGetInt64()).
+ 	 */
+	ArgxcValueStatus argxcGetBool(Argxc *argxc, const char *id, bool *value);
+
+	/**
+ 	 * @brief Read the value of an ARGX_VALUE_STRING option (see argxcGetInt64()).
+ 	 *
+ 	 * The string points into the instance's arguments and is valid until it is destroyed.
+ 	 */
+	ArgxcValueStatus argxcGetString(Argxc *argxc, const char *id, const char **value);
+
+	/**
+ 	 * @brief Read the value of an ARGX_VALUE_ENUM option: the position of the chosen sub-option.
+ 	 */
+	ArgxcValueStatus argxcGetEnum(Argxc *argxc, const char *id, size_t *value);
+
+	/**
+ 	 * @brief Test the presence bit of the sub-parameter at `index` (its position under the parent).
+ 	 *
+ 	 * @param param Pointer to the parameter.
+ 	 * @param index Position of the sub-parameter.
+ 	 * @return true if the sub-parameter exists, false otherwise.
+ 	 */
+	bool argxcParamHasSubAt(const ArgxcParam *param, size_t index);
+
 	/**
  	 * @brief Compare if the given argv matches a list of ArgxcOptions.
  	 *
+ 	 * Clustered short options are accepted (see argxcParse()); an attached value
+ 	 * (`-sprofessional`) must be a valid sub-parameter, like a separate one. Values of
+ 	 * typed options (`--opt=value`, `--opt value`) must convert to the declared type.
+ 	 *
  	 * @param options Array of ArgxcOptions.
  	 * @param optionsCount Number of options.
  	 * @param argv Array of argument strings.
@@ -96,6 +383,64 @@ extern "C" {
  	 */
 	bool argxcCompareArgs(ArgxcOptions *options, size_t optionsCount, char **argv, size_t argvCount);
 
+	/**
+ 	 * @brief Check argv like argxcCompareArgs() and describe the first argument it rejects.
+ 	 *
+ 	 * The diagnostic names the failing token and its position, and suggests the nearest
+ 	 * names it could stand for: the `param` / `sparam` of the options for an unknown option,
+ 	 * the sub-options of the parent for an unknown sub-option or enum value. Suggestions are
+ 	 * only computed on failure (see argxcSuggest()).
+ 	 *
+ 	 * @param options Array of ArgxcOptions.
+ 	 * @param optionsCount Number of options.
+ 	 * @param argv Array of argument strings.
+ 	 * @param argvCount Number of argument strings.
+ 	 * @param diagnostic Output: ARGX_DIAG_OK, or why and where argv was rejected (may be NULL).
+ 	 * @return true if argv matches the options, false otherwise.
+ 	 */
+	bool argxcDiagnoseArgs(ArgxcOptions *options, size_t optionsCount, char **argv, size_t argvCount,
+            ArgxcDiagnostic *diagnostic);
+
+	/**
+ 	 * @brief Check many argument vectors against one option table, across threads.
+ 	 *
+ 	 * Each vector is checked like argxcDiagnoseArgs() and gets its diagnostic at the same
+ 	 * index of `diagnostics` (ARGX_DIAG_OK when valid; a NULL vector is invalid with a
+ 	 * position of -1). The lookup tables over `options` are built once and shared read-only
+ 	 * by the threads. Each thread takes vectors in chunks of ARGX_BATCH_CHUNK from its own
+ 	 * share, then steals half of a busier thread's remaining share, so long vectors do not
+ 	 * leave threads idle. `options` must not change during the call.
+ 	 *
+ 	 * @param options Array of ArgxcOptions.
+ 	 * @param optionsCount Number of options.
+ 	 * @param argvs Argument vectors (argv[0] of each is skipped, as in argxcCompareArgs()).
+ 	 * @param argvCounts Number of arguments of each vector.
+ 	 * @param count Number of vectors.
+ 	 * @param threads Threads to use, the caller included (0 for one per online CPU).
+ 	 * @param diagnostics Output: `count` diagnostics, in the order of `argvs`.
+ 	 * @return size_t Number of valid vectors.
+ 	 */
+	size_t argxcDiagnoseBatch(ArgxcOptions *options, size_t optionsCount, char **const *argvs, const size_t *argvCounts,
+            size_t count, size_t threads, ArgxcDiagnostic *diagnostics);
+
+	/**
+ 	 * @brief List the option names closest to a mistyped token ("did you mean").
+ 	 *
+ 	 * Compares `token` with the `param` and `sparam` of each option (not their sub-options)
+ 	 * by Levenshtein distance, with a bit-parallel algorithm handling 64 token characters per
+ 	 * step; names within about one edit per three characters are kept, closest first, ties
+ 	 * in declaration order.
+ 	 *
+ 	 * @param options Array of ArgxcOptions.
+ 	 * @param optionsCount Number of options.
+ 	 * @param token Token to match.
+ 	 * @param names Output: up to `max` names (at most ARGX_SUGGEST_MAX); they point into the options.
+ 	 * @param max Capacity of `names`.
+ 	 * @return size_t Number of names written.
+ 	 */
+	size_t argxcSuggest(const ArgxcOptions *options, size_t optionsCount, const char *token, const char **names,
+            size_t max);
+
 	/**
  	 * @brief Generate documentation for the defined options.
  	 *
@@ -107,15 +452,62 @@ extern "C" {
  	 */
 	char *argxcCreateDocs(Argxc *argxc, ArgxcStyle style, const char *title, const char *mainInfo);
 
+	/**
+ 	 * @brief Stream the documentation through a sink callback without building a string.
+ 	 *
+ 	 * Renders in a single linear pass and never allocates; the text is identical to
+ 	 * the one returned by argxcCreateDocs() (without the terminating NUL).
+ 	 *
+ 	 * @param argxc Pointer to the Argxc instance.
+ 	 * @param style Documentation output style.
+ 	 * @param title Title of the documentation.
+ 	 * @param mainInfo Additional info to be displayed in the documentation.
+ 	 * @param sink Callback receiving consecutive pieces of the output.
+ 	 * @param userData Pointer passed back to `sink`.
+ 	 * @return true if every piece was accepted, false if `sink` stopped the rendering.
+ 	 */
+	bool argxcWriteDocs(Argxc *argxc, ArgxcStyle style, const char *title, const char *mainInfo,
+            ArgxcDocsSink sink, void *userData);
+
+	/**
+ 	 * @brief Stream the documentation straight to a FILE (e.g., stdout).
+ 	 *
+ 	 * @return true on success, false on a write error.
+ 	 */
+	bool argxcWriteDocsToFile(Argxc *argxc, ArgxcStyle style, const char *title, const char *mainInfo, FILE *file);
+
+	/**
+ 	 * @brief Compute the exact length of the documentation without rendering it.
+ 	 *
+ 	 * @return size_t Number of bytes, excluding the terminating NUL.
+ 	 */
+	size_t argxcMeasureDocs(Argxc *argxc, ArgxcStyle style, const char *title, const char *mainInfo);
+
 	/**
  	 * @brief Get the raw command-line arguments passed to Argxc.
  	 *
+ 	 * The array and every string are copies that must be released with
+ 	 * argxcFreeStringArray(); prefer argxcGetMainArgsView() for read-only access.
+ 	 *
  	 * @param argxc Pointer to the Argxc instance.
  	 * @param count Output: number of arguments returned.
  	 * @return char** Array of argument strings.
  	 */
 	char **argxcGetMainArgs(Argxc *argxc, size_t *count);
 
+	/**
+ 	 * @brief Get a read-only view of the command-line arguments without allocating.
+ 	 *
+ 	 * Unlike argxcGetMainArgs(), nothing is copied and nothing must be freed. The view is
+ 	 * valid until the instance is destroyed or argxcReset() replaces its arguments (for
+ 	 * borrowed instances it is the caller's own argv).
+ 	 *
+ 	 * @param argxc Pointer to the Argxc instance.
+ 	 * @param count Output: number of arguments (may be NULL).
+ 	 * @return const char* const* Array of argument strings, or NULL.
+ 	 */
+	const char *const *argxcGetMainArgsView(const Argxc *argxc, size_t *count);
+
 	/**
  	 * @brief Get the number of command-line arguments passed.
  	 *
@@ -133,6 +525,14 @@ extern "C" {
  	 */
 	ArgxcOptions *argxcGetOptions(Argxc *argxc, size_t *count);
 
+	/**
+ 	 * @brief Get the arena backing an Argxc instance.
+ 	 *
+ 	 * @param argxc Pointer to the Argxc instance.
+ 	 * @return ArgxcArena* The arena, or NULL if the instance uses the C heap.
+ 	 */
+	ArgxcArena *argxcGetArena(Argxc *argxc);
+
 	/**
  	 * @brief Get the identifier of the Argxc instance.
  	 *
@@ -144,6 +544,11 @@ extern "C" {
 	/**
  	 * @brief Create a new option.
  	 *
+ 	 * The strings are copied into one read-only block owned by the option (equal fields
+ 	 * share a copy), freed by the last holder of the option (see argxcFreeOption()). Do
+ 	 * not write through or reassign the `id`, `param`, `sparam` and `info` fields: lookups
+ 	 * read the length and hash stored in front of each handle.
+ 	 *
  	 * @param id Option identifier.
  	 * @param param Parameter name (e.g., --param).
  	 * @param sparam Short form (e.g., -p).
@@ -155,6 +560,24 @@ extern "C" {
 	ArgxcOptions argxcCreateOption(const char *id, const char *param, const char *sparam, 
             const char *info, bool hasSubParams, bool hasAnySubParams);
 
+	/**
+ 	 * @brief Create a new option whose strings (and later sub-options) live in an arena.
+ 	 *
+ 	 * The arena must outlive every instance the option is added to; argxcFreeOption()
+ 	 * leaves arena memory alone. Options of one arena share one copy of each distinct string.
+ 	 *
+ 	 * @param arena Arena to allocate from (NULL behaves like argxcCreateOption()).
+ 	 * @param id Option identifier.
+ 	 * @param param Parameter name (e.g., --param).
+ 	 * @param sparam Short form (e.g., -p).
+ 	 * @param info Description of the option.
+ 	 * @param hasSubParams Whether the option has sub-parameters.
+ 	 * @param hasAnySubParams Whether the option accepts any sub-parameters.
+ 	 * @return ArgxcOptions The created option.
+ 	 */
+	ArgxcOptions argxcCreateOptionIn(ArgxcArena *arena, const char *id, const char *param, const char *sparam, 
+            const char *info, bool hasSubParams, bool hasAnySubParams);
+
 	/**
  	 * @brief Free resources associated with an ArgxcOptions struct.
  	 *
@@ -165,6 +588,8 @@ extern "C" {
 	/**
  	 * @brief Free resources associated with an ArgxcParam struct.
  	 *
+ 	 * Parameters no longer own memory, so this only resets the struct; kept for compatibility.
+ 	 *
  	 * @param param Pointer to the parameter to free.
  	 */
 	void argxcFreeParam(ArgxcParam *param);
@@ -17,6 +17,39 @@
 #define ARGX_VERSION_CHECK(ARGX_VERSION_MAJOR, ARGX_VERSION_MINOR, ARGX_VERSION_PATCH, ARGX_VERSION_STATE) \
     (((ARGX_VERSION_MAJOR)<<16)|((ARGX_VERSION_MINOR)<<8)|(ARGX_VERSION_PATCH)|((ARGX_VERSION_STATE) << 24))
 
+// Arena allocator
+#define ARGX_ARENA_ALIGN              16
+#define ARGX_ARENA_DEFAULT_CHUNK      (4 * 1024)
+#define ARGX_ARENA_MAX_CHUNK          (1024 * 1024)
+
+// Response files (@file): default nesting limit
+#define ARGX_RESPONSE_MAX_DEPTH       16
+
+// Statistics (argxcGetStats): 1 collects them, 0 compiles every counter out
+#ifndef ARGX_STATS
+#	define ARGX_STATS 0
+#endif
+
+// Tracing (argxcTraceStart): 1 compiles the trace points in, 0 compiles them out
+#ifndef ARGX_TRACE
+#	define ARGX_TRACE 0
+#endif
+
+// Argument classification: 1 scans tokens with SSE2/AVX2/NEON when available, 0 with a scalar loop
+#ifndef ARGX_SIMD
+#	define ARGX_SIMD 1
+#endif
+
+// Events held by the trace ring buffer when argxcTraceStart() is given 0
+#define ARGX_TRACE_DEFAULT_CAPACITY   (64 * 1024)
+
+// "Did you mean" suggestions: most names kept per token (see argxcSuggest)
+#define ARGX_SUGGEST_MAX              4
+
+// Batch validation (argxcDiagnoseBatch): most threads of one call, and vectors taken at once
+#define ARGX_BATCH_MAX_THREADS        256
+#define ARGX_BATCH_CHUNK              32
+
 // DEV or PROD
 #define ARGX_DEV false
 
@@ -2,6 +2,9 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
+
+#include "macros.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -12,6 +15,12 @@ extern "C" {
     	ARGX_STYLE_SIMPLE
 	} ArgxcStyle;
 
+	// Parsing behaviour, combined with `|` (see argxcSetFlags)
+	typedef enum {
+    	ARGX_FLAG_NONE = 0,
+    	ARGX_FLAG_ABBREV = 1 << 0      // Accept unique prefixes of long options (`--vers` for `--version`)
+	} ArgxcFlags;
+
 	typedef struct {
     	char *type;
     	char *error;
@@ -19,8 +28,43 @@ extern "C" {
     	int code;
 	} ArgxcError;
 
-	// Forward declaration
+	// Type of the value an option takes (see argxcSetOptionValueType)
+	typedef enum {
+    	ARGX_VALUE_NONE,       // Plain flag, no value (default)
+    	ARGX_VALUE_INT64,
+    	ARGX_VALUE_UINT64,
+    	ARGX_VALUE_DOUBLE,
+    	ARGX_VALUE_BOOL,       // `--opt` alone is true; `--opt=no` sets it explicitly
+    	ARGX_VALUE_STRING,
+    	ARGX_VALUE_ENUM        // One of the option's sub-options; the value is its position
+	} ArgxcValueType;
+
+	// Outcome of a typed getter
+	typedef enum {
+    	ARGX_VALUE_UNSET,      // Neither the option nor its value was given
+    	ARGX_VALUE_OK,
+    	ARGX_VALUE_INVALID,    // The text does not convert to the declared type
+    	ARGX_VALUE_MISSING,    // The option ends the command line without its value
+    	ARGX_VALUE_MISMATCH    // The option is not declared with the requested type
+	} ArgxcValueStatus;
+
+	// Forward declarations
 	struct ArgxcOptions;
+	struct ArgxcIndex;
+
+	// Opaque handle for the bump allocator (see ARGXArena.h)
+	typedef struct ArgxcArena ArgxcArena;
+
+	// Handler of an option, run in argv order by argxcDispatch(): `handle` is the spec node of
+	// the option, `position` its argv position and `value` its text (after `=`, the next
+	// token, or the rest of a `-ovalue` cluster), NULL if none. Return false to stop parsing.
+	typedef bool (*ArgxcAction)(void *userData, const char *id, size_t handle, int position, const char *value);
+
+	// Action of one spec node (see argxcSpecDispatch)
+	typedef struct {
+    	ArgxcAction action;    // NULL for none
+    	void *userData;
+	} ArgxcActionBinding;
 
 	typedef struct ArgxcOptions {
     	char *id;              // ID of the option
@@ -32,17 +76,99 @@ extern "C" {
     	struct ArgxcOptions *subParams;
     	size_t subParamsCount;
     	size_t subParamsCapacity;
+    	struct ArgxcIndex *subIndex; // Hash index over `subParams` (managed by argxcAddSubOption)
+    	ArgxcArena *arena;     // Owner of the strings and `subParams`, NULL for the C heap
+    	bool interned;         // Strings are shared read-only handles made by argxcCreateOption*(): never reassign or write them
+    	ArgxcValueType valueType;
+    	ArgxcAction action;    // Run by argxcDispatch() when the option is given (see argxcSetOptionAction)
+    	void *actionData;
 	} ArgxcOptions;
 
+	// Option of a static table (see ARGXStatic.h): a flat record with the handle of its
+	// parent instead of a `subParams` array, so whole tables can be `static const`
+	typedef struct {
+    	const char *id;
+    	const char *param;
+    	const char *sparam;
+    	const char *info;
+    	int parent;            // Handle of the parent option, -1 for top-level options
+    	bool hasSubParams;
+    	bool hasAnySubParams;
+    	ArgxcValueType valueType;
+	} ArgxcStaticOption;
+
+	// Sub-parameter presence is a bitset: bit `i` is set when sub-parameter `i` was given.
+	// The first 64 bits are stored inline; wider options also get `subExistsWide`, which
+	// points into the parse result, so a parameter never owns memory.
 	typedef struct {
     	bool exists;
-    	bool *subExists;
     	size_t subExistsCount;
+    	uint64_t subExistsBits;          // Bits of sub-parameters 0..63
+    	const uint64_t *subExistsWide;   // Every bit when `subExistsCount` > 64, NULL otherwise
+    	size_t node;                     // Spec node of the parameter (used by argxcGetSubParam)
 	} ArgxcParam;
 
+	// Work done by an instance, collected when the library is built with ARGX_STATS
+	// (see argxcGetStats). Times are wall-clock nanoseconds.
+	typedef struct {
+    	uint64_t tokensScanned;   // Arguments examined by parses and argxcCompareArgs
+    	uint64_t stringCompares;  // Byte-wise name comparisons (after a hash or length match)
+    	uint64_t hashProbes;      // Index buckets examined
+    	uint64_t allocations;     // Calls to the C allocator (arena chunks included)
+    	uint64_t allocatedBytes;
+    	uint64_t createNs;
+    	uint64_t parseNs;         // Parses and argxcCompareArgs
+    	uint64_t lookupNs;        // argxcGetParam, argxcFindParam, argxcGetSubParam
+    	uint64_t docsNs;          // argxcCreateDocs
+	} ArgxcStats;
+
+	// Why argxcDiagnoseArgs() rejected a command line
+	typedef enum {
+    	ARGX_DIAG_OK,                // Every argument matched
+    	ARGX_DIAG_UNKNOWN_OPTION,    // `token` is neither an option nor a cluster of short options
+    	ARGX_DIAG_UNKNOWN_SUB_OPTION, // `token` is not a sub-option of `parent`
+    	ARGX_DIAG_INVALID_VALUE      // `token` does not convert to the value type of `parent`
+	} ArgxcDiagnosticKind;
+
+	// First argument rejected by argxcDiagnoseArgs(), with the nearest names it could stand for
+	typedef struct {
+    	ArgxcDiagnosticKind kind;
+    	int position;                // Argv position of `token`, -1 when every argument matched
+    	const char *token;           // Points into argv, NULL if none
+    	const char *parent;          // Id of the option expecting `token`, NULL for an unknown option
+    	size_t suggestionsCount;
+    	const char *suggestions[ARGX_SUGGEST_MAX]; // Closest first; they point into the options
+	} ArgxcDiagnostic;
+
+	// Outcome of argxcTokenize()
+	typedef enum {
+    	ARGX_TOKENIZE_OK,
+    	ARGX_TOKENIZE_INCOMPLETE,    // The line ends inside quotes or after a `\`: append the next line and retry
+    	ARGX_TOKENIZE_NO_MEMORY
+	} ArgxcTokenizeStatus;
+
+	// Command line split by argxcTokenize(). Every token points into `buffer`; both arrays are
+	// kept by the next call on the same struct, and only grow when a line needs more room.
+	// Zero-initialize before the first call.
+	typedef struct {
+    	char **argv;           // `argc` tokens followed by NULL
+    	int argc;
+    	int endOfOptions;      // Position of the first unquoted `--` token, -1 if none
+    	char *buffer;          // Unquoted tokens, each NUL-terminated
+    	size_t bufferCapacity;
+    	size_t argvCapacity;
+	} ArgxcTokens;
+
+	// Output callback for the documentation renderer and argxcTraceWrite; return false to stop writing
+	typedef bool (*ArgxcDocsSink)(void *userData, const char *data, size_t len);
+
 	// Opaque handle for Argxc instance
 	typedef struct Argxc Argxc;
 
+	// Opaque handles for a compiled, read-only option spec and one parse against it (see ARGXSpec.h)
+	typedef struct ArgxcSpec ArgxcSpec;
+	typedef struct ArgxcResult ArgxcResult;
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,211 @@
+/* src/ARGXArena.c
+ * Owned and created by: pcannon09
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "../inc/ARGXArena.h"
+#include "../inc/macros.h"
+
+#include "ARGXIndex.h"
+#include "ARGXIntern.h"
+#include "ARGXStats.h"
+
+typedef struct ArgxcArenaChunk {
+    struct ArgxcArenaChunk *next;
+    size_t size;
+    size_t used;
+} ArgxcArenaChunk;
+
+struct ArgxcArena {
+    ArgxcArenaChunk *head;     // Chunk currently being filled
+    size_t chunkSize;          // Size of the next chunk; doubles up to ARGX_ARENA_MAX_CHUNK
+    size_t chunkCount;
+    size_t used;
+    void *last;                // Most recent allocation (can grow in place)
+    ArgxcIndex *strings;       // Handles of argxcIntern(), NULL until the first
+};
+
+// Chunk payload starts right after the (aligned) header
+#define ARGX_ARENA_HEADER (((sizeof(ArgxcArenaChunk) + ARGX_ARENA_ALIGN - 1) / ARGX_ARENA_ALIGN) * ARGX_ARENA_ALIGN)
+
+static size_t alignSize(size_t size)
+{
+    return (size + ARGX_ARENA_ALIGN - 1) & ~(size_t)(ARGX_ARENA_ALIGN - 1);
+}
+
+static unsigned char *chunkData(ArgxcArenaChunk *chunk)
+{
+    return (unsigned char *)chunk + ARGX_ARENA_HEADER;
+}
+
+static ArgxcArenaChunk *pushChunk(ArgxcArena *arena, size_t minSize)
+{
+    size_t size = minSize > arena->chunkSize ? minSize : arena->chunkSize;
+    ArgxcArenaChunk *chunk = malloc(ARGX_ARENA_HEADER + size);
+    if (!chunk) return NULL;
+
+    ARGX_STATS_ALLOC(ARGX_ARENA_HEADER + size);
+
+    chunk->next = arena->head;
+    chunk->size = size;
+    chunk->used = 0;
+
+    arena->head = chunk;
+    arena->chunkCount++;
+
+    if (arena->chunkSize < ARGX_ARENA_MAX_CHUNK) arena->chunkSize *= 2;
+
+    return chunk;
+}
+
+ArgxcArena *argxcArenaCreate(size_t chunkSize)
+{
+    ArgxcArena *arena = malloc(sizeof(ArgxcArena));
+    if (!arena) return NULL;
+
+    ARGX_STATS_ALLOC(sizeof(ArgxcArena));
+
+    arena->head = NULL;
+    arena->chunkSize = alignSize(chunkSize == 0 ? ARGX_ARENA_DEFAULT_CHUNK : chunkSize);
+    arena->chunkCount = 0;
+    arena->used = 0;
+    arena->last = NULL;
+    arena->strings = NULL;
+
+    return arena;
+}
+
+void argxcArenaDestroy(ArgxcArena *arena)
+{
+    if (!arena) return;
+
+    ArgxcArenaChunk *chunk = arena->head;
+
+    while (chunk)
+	{
+        ArgxcArenaChunk *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+
+    free(arena); arena = NULL;
+}
+
+void *argxcArenaAlloc(ArgxcArena *arena, size_t size)
+{
+    if (!arena)
+	{
+        ARGX_STATS_ALLOC(size);
+        return malloc(size);
+    }
+
+    size = alignSize(size == 0 ? 1 : size);
+
+    ArgxcArenaChunk *chunk = arena->head;
+
+    if (!chunk || chunk->size - chunk->used < size)
+	{
+        chunk = pushChunk(arena, size);
+        if (!chunk) return NULL;
+    }
+
+    void *ptr = chunkData(chunk) + chunk->used;
+
+    chunk->used += size;
+    arena->used += size;
+    arena->last = ptr;
+
+    return ptr;
+}
+
+void *argxcArenaCalloc(ArgxcArena *arena, size_t count, size_t size)
+{
+    if (!arena)
+	{
+        ARGX_STATS_ALLOC(count * size);
+        return calloc(count, size);
+    }
+    if (size != 0 && count > (size_t)-1 / size) return NULL;
+
+    void *ptr = argxcArenaAlloc(arena, count * size);
+    if (ptr) memset(ptr, 0, count * size);
+
+    return ptr;
+}
+
+void *argxcArenaRealloc(ArgxcArena *arena, void *ptr, size_t oldSize, size_t newSize)
+{
+    if (!arena)
+	{
+        ARGX_STATS_ALLOC(newSize);
+        return realloc(ptr, newSize);
+    }
+    if (!ptr) return argxcArenaAlloc(arena, newSize);
+
+    ArgxcArenaChunk *chunk = arena->head;
+
+    // Grow the most recent allocation in place when the chunk has room
+    if (ptr == arena->last && chunk)
+	{
+        size_t offset = (size_t)((unsigned char *)ptr - chunkData(chunk));
+        size_t alignedNew = alignSize(newSize == 0 ? 1 : newSize);
+
+        if (offset + alignedNew <= chunk->size)
+		{
+            arena->used = arena->used - (chunk->used - offset) + alignedNew;
+            chunk->used = offset + alignedNew;
+
+            return ptr;
+        }
+    }
+
+    void *newPtr = argxcArenaAlloc(arena, newSize);
+    if (!newPtr) return NULL;
+
+    memcpy(newPtr, ptr, oldSize < newSize ? oldSize : newSize);
+
+    return newPtr;
+}
+
+void argxcArenaFree(ArgxcArena *arena, void *ptr)
+{
+    if (!arena) free(ptr);
+}
+
+char *argxcArenaStrdup(ArgxcArena *arena, const char *str)
+{
+    if (!str) return NULL;
+
+    size_t len = strlen(str) + 1;
+    char *dup = argxcArenaAlloc(arena, len);
+
+    if (dup)
+	{
+        memcpy(dup, str, len);
+    }
+
+    return dup;
+}
+
+size_t argxcArenaGetUsed(const ArgxcArena *arena)
+{
+    return arena ? arena->used : 0;
+}
+
+size_t argxcArenaGetChunkCount(const ArgxcArena *arena)
+{
+    return arena ? arena->chunkCount : 0;
+}
+
+ArgxcIndex *argxcArenaStrings(ArgxcArena *arena)
+{
+    if (!arena->strings)
+	{
+        arena->strings = argxcArenaCalloc(arena, 1, sizeof(ArgxcIndex));
+        if (arena->strings) arena->strings->arena = arena;
+    }
+
+    return arena->strings;
+}
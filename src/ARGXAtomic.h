@@ -0,0 +1,33 @@
+/* src/ARGXAtomic.h
+ * Owned and created by: pcannon09
+ * Minimal 64-bit atomics over compiler builtins (the library is C99, without <stdatomic.h>)
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#	include <intrin.h>
+
+// Interlocked operations are full barriers, which covers every ordering below
+#	define ARGX_ATOMIC_LOAD(ptr) ((uint64_t)_InterlockedCompareExchange64((volatile long long *)(ptr), 0, 0))
+#	define ARGX_ATOMIC_LOAD_ACQUIRE(ptr) ARGX_ATOMIC_LOAD(ptr)
+#	define ARGX_ATOMIC_STORE(ptr, value) ((void)_InterlockedExchange64((volatile long long *)(ptr), (long long)(value)))
+#	define ARGX_ATOMIC_STORE_RELEASE(ptr, value) ARGX_ATOMIC_STORE(ptr, value)
+#	define ARGX_ATOMIC_FETCH_ADD(ptr, n) ((uint64_t)_InterlockedExchangeAdd64((volatile long long *)(ptr), (long long)(n)))
+#	define ARGX_ATOMIC_CAS(ptr, expected, desired) \
+    	(_InterlockedCompareExchange64((volatile long long *)(ptr), (long long)(desired), (long long)(expected)) == (long long)(expected))
+#	define ARGX_ATOMIC_FENCE_ACQUIRE() _ReadWriteBarrier()
+#	define ARGX_ATOMIC_FENCE_RELEASE() _ReadWriteBarrier()
+#else
+#	define ARGX_ATOMIC_LOAD(ptr) __atomic_load_n(ptr, __ATOMIC_RELAXED)
+#	define ARGX_ATOMIC_LOAD_ACQUIRE(ptr) __atomic_load_n(ptr, __ATOMIC_ACQUIRE)
+#	define ARGX_ATOMIC_STORE(ptr, value) __atomic_store_n(ptr, value, __ATOMIC_RELAXED)
+#	define ARGX_ATOMIC_STORE_RELEASE(ptr, value) __atomic_store_n(ptr, value, __ATOMIC_RELEASE)
+#	define ARGX_ATOMIC_FETCH_ADD(ptr, n) __atomic_fetch_add(ptr, n, __ATOMIC_ACQ_REL)
+// Replace `*ptr` by `desired` if it still holds `expected`; true on success (full barrier)
+#	define ARGX_ATOMIC_CAS(ptr, expected, desired) __sync_bool_compare_and_swap(ptr, expected, desired)
+#	define ARGX_ATOMIC_FENCE_ACQUIRE() __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#	define ARGX_ATOMIC_FENCE_RELEASE() __atomic_thread_fence(__ATOMIC_RELEASE)
+#endif
@@ -0,0 +1,284 @@
+/* src/ARGXClassify.c
+ * Owned and created by: pcannon09
+ */
+
+#include <string.h>
+
+#include "../inc/macros.h"
+
+#include "ARGXAtomic.h"
+#include "ARGXClassify.h"
+#include "ARGXIndex.h"
+#include "ARGXStats.h"
+
+#if ARGX_SIMD && (defined(__SSE2__) || defined(_M_X64))
+#	define ARGX_CLASSIFY_SSE2 1
+#	include <emmintrin.h>
+#endif
+
+// AVX2 is compiled per function and only run when the CPU reports it
+#if ARGX_SIMD && ARGX_CLASSIFY_SSE2 && (defined(__GNUC__) || defined(__clang__))
+#	define ARGX_CLASSIFY_AVX2 1
+#	include <immintrin.h>
+#endif
+
+#if ARGX_SIMD && (defined(__aarch64__) || defined(_M_ARM64))
+#	define ARGX_CLASSIFY_NEON 1
+#	include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#	include <intrin.h>
+#endif
+
+// Vector scans load whole aligned blocks, which may extend past the terminator (never across
+// a page): fine for the hardware, but AddressSanitizer would flag the bytes after the string
+#if defined(__SANITIZE_ADDRESS__)
+#	define ARGX_NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+#elif defined(__has_feature)
+#	if __has_feature(address_sanitizer)
+#		define ARGX_NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+#	endif
+#endif
+
+#ifndef ARGX_NO_SANITIZE_ADDRESS
+#	define ARGX_NO_SANITIZE_ADDRESS
+#endif
+
+enum {
+    SCAN_UNRESOLVED,
+    SCAN_SCALAR,
+    SCAN_SSE2,
+    SCAN_AVX2,
+    SCAN_NEON
+};
+
+// Routine picked on first use; threads racing to pick it pick the same one
+static uint64_t scanLevel = SCAN_UNRESOLVED;
+
+#if ARGX_CLASSIFY_SSE2 || ARGX_CLASSIFY_NEON
+static unsigned int lowestBit(uint64_t mask)
+{
+#	if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+
+    return (unsigned int)index;
+#	else
+    return (unsigned int)__builtin_ctzll(mask);
+#	endif
+}
+#endif
+
+// Each scan returns the length of `token` and stores the offset of its first `=` (or the
+// length) in `split`
+static size_t scanScalar(const char *token, size_t *split)
+{
+    size_t i = 0;
+
+    while (token[i] && token[i] != '=') i++;
+
+    *split = i;
+
+    return token[i] ? i + strlen(token + i) : i;
+}
+
+#if ARGX_CLASSIFY_SSE2
+ARGX_NO_SANITIZE_ADDRESS
+static size_t scanSse2(const char *token, size_t *split)
+{
+    const char *block = (const char *)((uintptr_t)token & ~(uintptr_t)15);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i equals = _mm_set1_epi8('=');
+    unsigned int skip = (unsigned int)(token - block);
+    size_t found = SIZE_MAX;
+
+    for (;; block += 16, skip = 0)
+	{
+        __m128i bytes = _mm_load_si128((const __m128i *)block);
+        uint64_t ends = (uint64_t)((unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, zero)) >> skip << skip);
+        uint64_t splits = (uint64_t)((unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, equals)) >> skip << skip);
+
+        if (found == SIZE_MAX && splits && (!ends || lowestBit(splits) < lowestBit(ends)))
+		{
+            found = (size_t)(block - token) + lowestBit(splits);
+        }
+
+        if (ends)
+		{
+            size_t length = (size_t)(block - token) + lowestBit(ends);
+            *split = found == SIZE_MAX ? length : found;
+
+            return length;
+        }
+    }
+}
+#endif
+
+#if ARGX_CLASSIFY_AVX2
+ARGX_NO_SANITIZE_ADDRESS __attribute__((target("avx2")))
+static size_t scanAvx2(const char *token, size_t *split)
+{
+    const char *block = (const char *)((uintptr_t)token & ~(uintptr_t)31);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i equals = _mm256_set1_epi8('=');
+    unsigned int skip = (unsigned int)(token - block);
+    size_t found = SIZE_MAX;
+
+    for (;; block += 32, skip = 0)
+	{
+        __m256i bytes = _mm256_load_si256((const __m256i *)block);
+        uint64_t ends = (uint64_t)((uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, zero)) >> skip << skip);
+        uint64_t splits = (uint64_t)((uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, equals)) >> skip << skip);
+
+        if (found == SIZE_MAX && splits && (!ends || lowestBit(splits) < lowestBit(ends)))
+		{
+            found = (size_t)(block - token) + lowestBit(splits);
+        }
+
+        if (ends)
+		{
+            size_t length = (size_t)(block - token) + lowestBit(ends);
+            *split = found == SIZE_MAX ? length : found;
+
+            return length;
+        }
+    }
+}
+#endif
+
+#if ARGX_CLASSIFY_NEON
+// Four bits per byte of a comparison (NEON has no movemask)
+static uint64_t neonMask(uint8x16_t matches)
+{
+    return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(matches), 4)), 0);
+}
+
+ARGX_NO_SANITIZE_ADDRESS
+static size_t scanNeon(const char *token, size_t *split)
+{
+    const char *block = (const char *)((uintptr_t)token & ~(uintptr_t)15);
+    unsigned int skip = (unsigned int)(token - block) * 4;
+    size_t found = SIZE_MAX;
+
+    for (;; block += 16, skip = 0)
+	{
+        uint8x16_t bytes = vld1q_u8((const uint8_t *)block);
+        uint64_t ends = neonMask(vceqq_u8(bytes, vdupq_n_u8(0))) >> skip << skip;
+        uint64_t splits = neonMask(vceqq_u8(bytes, vdupq_n_u8('='))) >> skip << skip;
+
+        if (found == SIZE_MAX && splits && (!ends || lowestBit(splits) < lowestBit(ends)))
+		{
+            found = (size_t)(block - token) + lowestBit(splits) / 4;
+        }
+
+        if (ends)
+		{
+            size_t length = (size_t)(block - token) + lowestBit(ends) / 4;
+            *split = found == SIZE_MAX ? length : found;
+
+            return length;
+        }
+    }
+}
+#endif
+
+static uint64_t resolveScan(void)
+{
+#if ARGX_CLASSIFY_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return SCAN_AVX2;
+#endif
+
+#if ARGX_CLASSIFY_SSE2
+    return SCAN_SSE2;
+#elif ARGX_CLASSIFY_NEON
+    return SCAN_NEON;
+#else
+    return SCAN_SCALAR;
+#endif
+}
+
+static size_t scanToken(const char *token, size_t *split)
+{
+    uint64_t level = ARGX_ATOMIC_LOAD(&scanLevel);
+
+    if (level == SCAN_UNRESOLVED)
+	{
+        level = resolveScan();
+        ARGX_ATOMIC_STORE(&scanLevel, level);
+    }
+
+    switch (level)
+	{
+#if ARGX_CLASSIFY_AVX2
+        case SCAN_AVX2: return scanAvx2(token, split);
+#endif
+#if ARGX_CLASSIFY_SSE2
+        case SCAN_SSE2: return scanSse2(token, split);
+#endif
+#if ARGX_CLASSIFY_NEON
+        case SCAN_NEON: return scanNeon(token, split);
+#endif
+        default: return scanScalar(token, split);
+    }
+}
+
+// Names are short: a token is hashed byte by byte while it can still be one (the hash
+// loop finds its end and `=` for free), and only what is left beyond is scanned by vectors
+static inline void classifyToken(const char *token, size_t hashLimit, ArgxcTokenInfo *info)
+{
+    uint32_t hash = ARGX_INDEX_HASH_OFFSET;
+    size_t length = 0;
+    size_t split;
+    bool equals = false; // Branch-free in the loop; the rare `=` is located afterwards
+
+    for (; token[length] && length <= hashLimit; length++)
+	{
+        unsigned char c = (unsigned char)token[length];
+
+        equals |= c == '=';
+        hash ^= c;
+        hash *= ARGX_INDEX_HASH_PRIME;
+    }
+
+    info->hashed = token[length] == '\0' && length <= hashLimit;
+    info->hash = info->hashed ? hash : 0;
+    info->reserved = 0;
+
+    split = equals ? (size_t)((const char *)memchr(token, '=', length) - token) : length;
+
+    if (token[length] != '\0')
+	{
+        size_t restSplit = 0;
+        size_t rest = scanToken(token + length, &restSplit);
+
+        if (!equals) split = length + restSplit;
+        length += rest;
+    }
+
+    info->length = length < UINT32_MAX ? (uint32_t)length : UINT32_MAX;
+    info->split = split < UINT32_MAX ? (uint32_t)split : UINT32_MAX;
+
+    if (token[0] != '-') info->kind = ARGX_TOKEN_WORD;
+    else if (token[1] == '\0') info->kind = ARGX_TOKEN_DASH;
+    else if (token[1] != '-') info->kind = ARGX_TOKEN_SHORT;
+    else info->kind = token[2] == '\0' ? ARGX_TOKEN_END_OF_OPTIONS : ARGX_TOKEN_LONG;
+}
+
+void argxcClassifyToken(const char *token, size_t hashLimit, ArgxcTokenInfo *info)
+{
+    classifyToken(token, hashLimit, info);
+}
+
+void argxcClassifyTokens(char *const argv[], size_t argc, size_t hashLimit, ArgxcTokenInfo *infos)
+{
+    ARGX_TRACE_BEGIN(ARGX_TRACE_CLASSIFY);
+
+    for (size_t k = 1; k < argc; k++)
+	{
+        if (argv[k]) classifyToken(argv[k], hashLimit, &infos[k]);
+    }
+
+    ARGX_TRACE_END(ARGX_TRACE_CLASSIFY);
+}
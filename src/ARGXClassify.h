@@ -0,0 +1,51 @@
+/* src/ARGXClassify.h
+ * Owned and created by: pcannon09
+ * Internal token classification: one vector scan per argument before resolving it
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+	// Shape of an argument, from its leading dashes
+	typedef enum {
+    	ARGX_TOKEN_WORD,           // No leading dash: a value, an operand or a command word
+    	ARGX_TOKEN_SHORT,          // `-x`, or a cluster (`-abc`, `-j8`)
+    	ARGX_TOKEN_LONG,           // `--name`, `--name=value`
+    	ARGX_TOKEN_DASH,           // `-` alone
+    	ARGX_TOKEN_END_OF_OPTIONS  // `--` alone
+	} ArgxcTokenKind;
+
+	// What the resolvers need to know about an argument, derived once
+	typedef struct {
+    	uint32_t length;       // strlen(), saturated at UINT32_MAX
+    	uint32_t split;        // Offset of the first `=`, `length` if none
+    	uint32_t hash;         // argxcIndexHash() of the whole token when `hashed`
+    	uint8_t kind;          // ArgxcTokenKind
+    	uint8_t hashed;        // Not longer than the hash limit: longer tokens match no name
+    	uint16_t reserved;
+	} ArgxcTokenInfo;
+
+	/**
+ 	 * @brief Describe one argument.
+ 	 *
+ 	 * The first `hashLimit` + 1 bytes are hashed as they are read; the rest of a longer token
+ 	 * is left unhashed and scanned for its end and `=` by vectors (AVX2 or SSE2 picked at run
+ 	 * time on x86, NEON on ARM64, a scalar loop elsewhere or when built with ARGX_SIMD=0).
+ 	 */
+	void argxcClassifyToken(const char *token, size_t hashLimit, ArgxcTokenInfo *info);
+
+	/**
+ 	 * @brief Describe argv[1..argc) into infos[1..argc) (NULL arguments are left out).
+ 	 */
+	void argxcClassifyTokens(char *const argv[], size_t argc, size_t hashLimit, ArgxcTokenInfo *infos);
+
+#ifdef __cplusplus
+}
+#endif
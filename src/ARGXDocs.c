@@ -0,0 +1,226 @@
+/* src/ARGXDocs.c
+ * Owned and created by: pcannon09
+ * Streaming documentation renderer
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdbool.h>
+
+#include "../inc/Argx.h"
+#include "../inc/types.h"
+
+#include "ARGXStats.h"
+
+// Every piece of output goes through the writer; with no sink it only measures
+typedef struct {
+    ArgxcDocsSink sink;
+    void *userData;
+    size_t written;
+    bool ok;
+} ArgxcDocsWriter;
+
+// Fill state for the single allocation done by argxcCreateDocs()
+typedef struct {
+    char *data;
+    size_t len;
+} ArgxcDocsBuffer;
+
+static void emit(ArgxcDocsWriter *writer, const char *data, size_t len)
+{
+    if (!writer->ok || len == 0) return;
+
+    if (writer->sink && !writer->sink(writer->userData, data, len))
+	{
+        writer->ok = false;
+        return;
+    }
+
+    writer->written += len;
+}
+
+static void emitStr(ArgxcDocsWriter *writer, const char *str)
+{
+    if (str) emit(writer, str, strlen(str));
+}
+
+static void emitSpaces(ArgxcDocsWriter *writer, size_t count)
+{
+    static const char spaces[] = "                                ";
+
+    while (count > 0)
+	{
+        size_t chunk = count < sizeof(spaces) - 1 ? count : sizeof(spaces) - 1;
+
+        emit(writer, spaces, chunk);
+        count -= chunk;
+    }
+}
+
+static void renderProfessional(ArgxcDocsWriter *writer, const ArgxcOptions *opt)
+{
+    // Main option header line
+    emit(writer, "ID: ", 4);
+    emitStr(writer, opt->id);
+    emit(writer, "\n[ ", 3);
+    emitStr(writer, opt->sparam);
+    emit(writer, " | ", 3);
+    emitStr(writer, opt->param);
+
+    if (opt->hasSubParams && opt->subParamsCount > 0)
+	{
+        emit(writer, " [ ", 3);
+
+        for (size_t j = 0; j < opt->subParamsCount; j++)
+		{
+            emitStr(writer, opt->subParams[j].param);
+
+            if (j < opt->subParamsCount - 1) emit(writer, " | ", 3);
+            else emit(writer, " ", 1);
+        }
+
+        emit(writer, "] ] ", 4);
+    }
+    else
+	{
+        emit(writer, " ] ", 3);
+    }
+
+    emitStr(writer, opt->info);
+    emit(writer, "\n", 1);
+
+    // Print all sub-options, aligned under the main parameter
+    if (opt->hasSubParams && opt->subParamsCount > 0)
+	{
+        size_t paramLen = opt->param ? strlen(opt->param) : 0;
+
+        for (size_t j = 0; j < opt->subParamsCount; j++)
+		{
+            const ArgxcOptions *sub = &opt->subParams[j];
+
+            emitSpaces(writer, paramLen);
+            emit(writer, "  [ ", 4);
+            emitStr(writer, sub->sparam);
+            emit(writer, " | ", 3);
+            emitStr(writer, sub->param);
+            emit(writer, " ] ", 3);
+            emitStr(writer, sub->info);
+            emit(writer, "\n", 1);
+        }
+    }
+}
+
+static void renderSimpleLine(ArgxcDocsWriter *writer, const ArgxcOptions *opt, bool indent)
+{
+    if (indent) emit(writer, "  ", 2);
+
+    emitStr(writer, opt->sparam);
+    emit(writer, ", ", 2);
+    emitStr(writer, opt->param);
+    emit(writer, " - ", 3);
+    emitStr(writer, opt->info);
+    emit(writer, "\n", 1);
+}
+
+static void renderDocs(ArgxcDocsWriter *writer, Argxc *argxc, ArgxcStyle style, const char *title, const char *mainInfo)
+{
+    size_t optionsCount = 0;
+    ArgxcOptions *options = argxcGetOptions(argxc, &optionsCount);
+
+    emitStr(writer, title);
+    emit(writer, "\n", 1);
+    emitStr(writer, mainInfo);
+    emit(writer, "\n", 1);
+
+    for (size_t i = 0; i < optionsCount && writer->ok; i++)
+	{
+        const ArgxcOptions *opt = &options[i];
+
+        if (style == ARGX_STYLE_PROFESSIONAL)
+		{
+            renderProfessional(writer, opt);
+        }
+        else if (style == ARGX_STYLE_SIMPLE)
+		{
+            renderSimpleLine(writer, opt, false);
+
+            if (opt->hasSubParams && opt->subParamsCount > 0)
+			{
+                for (size_t j = 0; j < opt->subParamsCount; j++)
+				{
+                    renderSimpleLine(writer, &opt->subParams[j], true);
+                }
+            }
+        }
+    }
+}
+
+static bool bufferSink(void *userData, const char *data, size_t len)
+{
+    ArgxcDocsBuffer *buffer = userData;
+
+    memcpy(buffer->data + buffer->len, data, len);
+    buffer->len += len;
+
+    return true;
+}
+
+static bool fileSink(void *userData, const char *data, size_t len)
+{
+    return fwrite(data, 1, len, (FILE *)userData) == len;
+}
+
+size_t argxcMeasureDocs(Argxc *argxc, ArgxcStyle style, const char *title, const char *mainInfo)
+{
+    if (!argxc) return 0;
+
+    ArgxcDocsWriter writer = {NULL, NULL, 0, true};
+    renderDocs(&writer, argxc, style, title, mainInfo);
+
+    return writer.written;
+}
+
+bool argxcWriteDocs(Argxc *argxc, ArgxcStyle style, const char *title, const char *mainInfo,
+        ArgxcDocsSink sink, void *userData)
+{
+    if (!argxc || !sink) return false;
+
+    ArgxcDocsWriter writer = {sink, userData, 0, true};
+    renderDocs(&writer, argxc, style, title, mainInfo);
+
+    return writer.ok;
+}
+
+bool argxcWriteDocsToFile(Argxc *argxc, ArgxcStyle style, const char *title, const char *mainInfo, FILE *file)
+{
+    if (!file) return false;
+
+    return argxcWriteDocs(argxc, style, title, mainInfo, fileSink, file);
+}
+
+char *argxcCreateDocs(Argxc *argxc, ArgxcStyle style, const char *title, const char *mainInfo)
+{
+    if (!argxc) return NULL;
+
+    ARGX_TRACE_BEGIN(ARGX_TRACE_DOCS);
+    ARGX_STATS_BEGIN(argxcStatsOf(argxc));
+
+    // Measure first, then render into one exactly sized allocation
+    size_t totalLen = argxcMeasureDocs(argxc, style, title, mainInfo);
+
+    ArgxcDocsBuffer buffer = {malloc(totalLen + 1), 0};
+
+    if (buffer.data)
+	{
+        ARGX_STATS_ALLOC(totalLen + 1);
+
+        argxcWriteDocs(argxc, style, title, mainInfo, bufferSink, &buffer);
+        buffer.data[buffer.len] = '\0';
+    }
+
+    ARGX_STATS_END(docsNs);
+    ARGX_TRACE_END(ARGX_TRACE_DOCS);
+
+    return buffer.data;
+}
@@ -0,0 +1,153 @@
+/* src/ARGXIndex.c
+ * Owned and created by: pcannon09
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "ARGXIndex.h"
+#include "ARGXStats.h"
+
+// Keep the load factor under 1/2 so probe sequences stay short
+static bool indexGrow(ArgxcIndex *index)
+{
+    size_t newCapacity = index->capacity == 0 ? 16 : index->capacity * 2;
+    ArgxcIndexEntry *entries = argxcArenaCalloc(index->arena, newCapacity, sizeof(ArgxcIndexEntry));
+    if (!entries) return false;
+
+    // Callers never rely on the order duplicates are visited in
+    for (size_t i = 0; i < index->capacity; i++)
+	{
+        ArgxcIndexEntry *entry = &index->entries[i];
+        if (!entry->key) continue;
+
+        size_t pos = entry->hash & (newCapacity - 1);
+        while (entries[pos].key) pos = (pos + 1) & (newCapacity - 1);
+
+        entries[pos] = *entry;
+    }
+
+    argxcArenaFree(index->arena, index->entries);
+    index->entries = entries;
+    index->capacity = newCapacity;
+
+    return true;
+}
+
+static bool entryMatches(const ArgxcIndexEntry *entry, ArgxcIndexKind kind, const char *key, size_t len, uint32_t hash)
+{
+    ARGX_STATS_ADD(hashProbes, 1);
+
+    if (entry->hash != hash || entry->len != len || entry->kind != kind) return false;
+    if (entry->key == key) return true;
+
+    ARGX_STATS_ADD(stringCompares, 1);
+
+    return memcmp(entry->key, key, len) == 0;
+}
+
+uint32_t argxcIndexHash(const char *str, size_t *len)
+{
+    uint32_t hash = ARGX_INDEX_HASH_OFFSET;
+    size_t i = 0;
+
+    for (; str[i]; i++)
+	{
+        hash ^= (unsigned char)str[i];
+        hash *= ARGX_INDEX_HASH_PRIME;
+    }
+
+    if (len) *len = i;
+
+    return hash;
+}
+
+uint32_t argxcIndexHashBytes(const char *str, size_t len)
+{
+    uint32_t hash = ARGX_INDEX_HASH_OFFSET;
+
+    for (size_t i = 0; i < len; i++)
+	{
+        hash ^= (unsigned char)str[i];
+        hash *= ARGX_INDEX_HASH_PRIME;
+    }
+
+    return hash;
+}
+
+bool argxcIndexInsertHashed(ArgxcIndex *index, ArgxcIndexKind kind, const char *key,
+        size_t len, uint32_t hash, size_t slot)
+{
+    if (!index || !key) return false;
+
+    if ((index->count + 1) * 2 > index->capacity && !indexGrow(index)) return false;
+
+    size_t mask = index->capacity - 1;
+    size_t pos = hash & mask;
+
+    while (index->entries[pos].key) pos = (pos + 1) & mask;
+
+    index->entries[pos].key = key;
+    index->entries[pos].len = len;
+    index->entries[pos].slot = slot;
+    index->entries[pos].hash = hash;
+    index->entries[pos].kind = kind;
+    index->count++;
+
+    return true;
+}
+
+bool argxcIndexInsert(ArgxcIndex *index, ArgxcIndexKind kind, const char *key, size_t slot)
+{
+    if (!key) return true; // Nothing to index (e.g., option without short form)
+
+    size_t len = 0;
+    uint32_t hash = argxcIndexHash(key, &len);
+
+    return argxcIndexInsertHashed(index, kind, key, len, hash, slot);
+}
+
+size_t argxcIndexNext(const ArgxcIndex *index, size_t pos, ArgxcIndexKind kind, const char *key, size_t len, uint32_t hash)
+{
+    if (!index || index->capacity == 0 || pos == ARGX_INDEX_END) return ARGX_INDEX_END;
+
+    size_t mask = index->capacity - 1;
+
+    for (pos = (pos + 1) & mask; index->entries[pos].key; pos = (pos + 1) & mask)
+	{
+        if (entryMatches(&index->entries[pos], kind, key, len, hash)) return pos;
+    }
+
+    return ARGX_INDEX_END;
+}
+
+size_t argxcIndexFind(const ArgxcIndex *index, ArgxcIndexKind kind, const char *key, size_t len, uint32_t hash)
+{
+    if (!index || index->capacity == 0 || !key) return ARGX_INDEX_END;
+
+    size_t mask = index->capacity - 1;
+
+    for (size_t pos = hash & mask; index->entries[pos].key; pos = (pos + 1) & mask)
+	{
+        if (entryMatches(&index->entries[pos], kind, key, len, hash)) return pos;
+    }
+
+    return ARGX_INDEX_END;
+}
+
+void argxcIndexClear(ArgxcIndex *index)
+{
+    if (!index) return;
+
+    if (index->entries) memset(index->entries, 0, index->capacity * sizeof(ArgxcIndexEntry));
+    index->count = 0;
+}
+
+void argxcIndexFree(ArgxcIndex *index)
+{
+    if (!index) return;
+
+    argxcArenaFree(index->arena, index->entries); index->entries = NULL;
+    index->capacity = 0;
+    index->count = 0;
+}
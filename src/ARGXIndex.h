@@ -0,0 +1,101 @@
+/* src/ARGXIndex.h
+ * Owned and created by: pcannon09
+ * Internal open-addressing hash index used to resolve option ids and names
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../inc/ARGXArena.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+	// Key namespaces stored in the same index
+	typedef enum {
+    	ARGX_INDEX_ID,         // Option ID
+    	ARGX_INDEX_NAME,       // Long or short parameter (`param` / `sparam`)
+    	ARGX_INDEX_CHILD,      // Sub-option ID, hashed together with its parent
+    	ARGX_INDEX_CHILD_NAME, // Long or short parameter, hashed together with its parent
+    	ARGX_INDEX_STRING      // Interned string (see ARGXIntern.h); never stored in a spec
+	} ArgxcIndexKind;
+
+	typedef struct {
+    	const char *key;       // NULL marks an empty bucket
+    	size_t len;
+    	size_t slot;           // Index of the option in its owning array
+    	uint32_t hash;
+    	ArgxcIndexKind kind;
+	} ArgxcIndexEntry;
+
+	typedef struct ArgxcIndex {
+    	ArgxcIndexEntry *entries;
+    	size_t capacity;       // Always zero or a power of two
+    	size_t count;
+    	ArgxcArena *arena;     // Source of the buckets, NULL for the C heap
+	} ArgxcIndex;
+
+	#define ARGX_INDEX_END ((size_t)-1)
+
+	// FNV-1a parameters of argxcIndexHash(), for callers hashing as they scan
+	#define ARGX_INDEX_HASH_OFFSET 2166136261u
+	#define ARGX_INDEX_HASH_PRIME 16777619u
+
+	/**
+ 	 * @brief Hash a string with FNV-1a and report its length in the same pass.
+ 	 *
+ 	 * @param str String to hash.
+ 	 * @param len Output: length of the string.
+ 	 * @return uint32_t The hash.
+ 	 */
+	uint32_t argxcIndexHash(const char *str, size_t *len);
+
+	/**
+ 	 * @brief Hash the first `len` bytes of a string (e.g., the name in `--name=value`).
+ 	 */
+	uint32_t argxcIndexHashBytes(const char *str, size_t len);
+
+	/**
+ 	 * @brief Insert a key; duplicates are kept so every matching slot can be visited.
+ 	 *
+ 	 * @return false if memory allocation failed.
+ 	 */
+	bool argxcIndexInsert(ArgxcIndex *index, ArgxcIndexKind kind, const char *key, size_t slot);
+
+	/**
+ 	 * @brief Insert a key whose hash and length are already known.
+ 	 */
+	bool argxcIndexInsertHashed(ArgxcIndex *index, ArgxcIndexKind kind, const char *key,
+            size_t len, uint32_t hash, size_t slot);
+
+	/**
+ 	 * @brief Find the first bucket holding the key.
+ 	 *
+ 	 * @return size_t Bucket position, or ARGX_INDEX_END if absent.
+ 	 */
+	size_t argxcIndexFind(const ArgxcIndex *index, ArgxcIndexKind kind, const char *key, size_t len, uint32_t hash);
+
+	/**
+ 	 * @brief Continue a lookup started with argxcIndexFind().
+ 	 *
+ 	 * @return size_t Next bucket holding the same key, or ARGX_INDEX_END.
+ 	 */
+	size_t argxcIndexNext(const ArgxcIndex *index, size_t pos, ArgxcIndexKind kind, const char *key, size_t len, uint32_t hash);
+
+	/**
+ 	 * @brief Remove every key while keeping the allocated buckets.
+ 	 */
+	void argxcIndexClear(ArgxcIndex *index);
+
+	/**
+ 	 * @brief Free the buckets of an index.
+ 	 */
+	void argxcIndexFree(ArgxcIndex *index);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,128 @@
+/* src/ARGXIntern.c
+ * Owned and created by: pcannon09
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "ARGXIndex.h"
+#include "ARGXIntern.h"
+#include "ARGXStats.h"
+
+char *argxcIntern(ArgxcArena *arena, const char *str)
+{
+    if (!arena || !str) return NULL;
+
+    size_t len = 0;
+    uint32_t hash = argxcIndexHash(str, &len);
+
+    if (len >= UINT32_MAX) return NULL;
+
+    ArgxcIndex *strings = argxcArenaStrings(arena);
+    if (!strings) return NULL;
+
+    size_t pos = argxcIndexFind(strings, ARGX_INDEX_STRING, str, len, hash);
+    if (pos != ARGX_INDEX_END) return (char *)strings->entries[pos].key;
+
+    ArgxcInternHeader *header = argxcArenaAlloc(arena, sizeof(ArgxcInternHeader) + len + 1);
+    if (!header) return NULL;
+
+    char *handle = (char *)(header + 1);
+
+    header->hash = hash;
+    header->length = (uint32_t)len;
+    header->block = 0;
+    memcpy(handle, str, len + 1);
+
+    if (!argxcIndexInsertHashed(strings, ARGX_INDEX_STRING, handle, len, hash, 0)) return NULL;
+
+    return handle;
+}
+
+// Bytes of one handle, padded so the header after it stays aligned
+static size_t handleSize(size_t len)
+{
+    size_t align = sizeof(uint32_t);
+    return sizeof(ArgxcInternHeader) + (len + 1 + align - 1) / align * align;
+}
+
+bool argxcInternBlock(const char *const strs[], char *handles[], size_t count)
+{
+    size_t lengths[8];
+    size_t size = sizeof(ArgxcInternBlock);
+    bool any = false;
+
+    if (count > 8) return false;
+
+    for (size_t i = 0; i < count; i++)
+	{
+        handles[i] = NULL;
+        lengths[i] = strs[i] ? strlen(strs[i]) : 0;
+
+        if (lengths[i] >= UINT32_MAX) return false;
+
+        // Only the first of equal strings takes space
+        bool repeated = false;
+        for (size_t j = 0; strs[i] && j < i && !repeated; j++) repeated = strs[j] && strcmp(strs[i], strs[j]) == 0;
+
+        if (strs[i] && !repeated) size += handleSize(lengths[i]);
+        any = any || strs[i];
+    }
+
+    if (!any) return true;
+
+    ArgxcInternBlock *block = malloc(size);
+    if (!block) return false;
+
+    ARGX_STATS_ALLOC(size);
+
+    block->refs = 1;
+    block->held = 0;
+
+    char *next = (char *)(block + 1);
+
+    for (size_t i = 0; i < count; i++)
+	{
+        if (!strs[i]) continue;
+
+        for (size_t j = 0; j < i && !handles[i]; j++)
+		{
+            if (strs[j] && strcmp(strs[i], strs[j]) == 0) handles[i] = handles[j];
+        }
+
+        if (handles[i]) continue;
+
+        ArgxcInternHeader *header = (ArgxcInternHeader *)next;
+        size_t len = 0;
+
+        header->hash = argxcIndexHash(strs[i], &len);
+        header->length = (uint32_t)lengths[i];
+        handles[i] = (char *)(header + 1);
+        header->block = (uint32_t)(handles[i] - (char *)block);
+        memcpy(handles[i], strs[i], lengths[i] + 1);
+
+        next += handleSize(lengths[i]);
+    }
+
+    return true;
+}
+
+static ArgxcInternBlock *blockOf(const char *handle)
+{
+    return (ArgxcInternBlock *)(handle - ARGX_INTERN_HEADER(handle)->block);
+}
+
+void argxcInternAdopt(const char *handle)
+{
+    ArgxcInternBlock *block = blockOf(handle);
+
+    if (block->held) block->refs++;
+    else block->held = 1;
+}
+
+void argxcInternRelease(const char *handle)
+{
+    ArgxcInternBlock *block = blockOf(handle);
+
+    if (--block->refs == 0) free(block);
+}
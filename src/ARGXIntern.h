@@ -0,0 +1,75 @@
+/* src/ARGXIntern.h
+ * Owned and created by: pcannon09
+ * Internal string interner behind the ids, names and descriptions of options
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../inc/ARGXArena.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+	// Stored right before the text of every handle
+	typedef struct {
+    	uint32_t hash;         // argxcIndexHash() of the text
+    	uint32_t length;
+    	uint32_t block;        // Distance back to the ArgxcInternBlock of a heap handle, 0 in an arena
+	} ArgxcInternHeader;
+
+	// Start of the single allocation holding the handles of one heap option
+	typedef struct {
+    	uint32_t refs;         // Holders of the option, each releasing the block once
+    	uint32_t held;         // The option was added to a parent or an instance
+	} ArgxcInternBlock;
+
+	#define ARGX_INTERN_HEADER(str) ((ArgxcInternHeader *)((const char *)(str) - sizeof(ArgxcInternHeader)))
+
+	/**
+ 	 * @brief Get the handle of a string in an arena: equal strings share one handle.
+ 	 *
+ 	 * The table belongs to the arena and goes with it, so each distinct id, name and
+ 	 * description is stored once per arena, and two of its handles are equal exactly when
+ 	 * they are the same pointer.
+ 	 *
+ 	 * @return char* The handle (its text is the string), or NULL if `str` is NULL or memory
+ 	 * allocation failed.
+ 	 */
+	char *argxcIntern(ArgxcArena *arena, const char *str);
+
+	/**
+ 	 * @brief Make handles of the strings of one heap option in a single C heap block.
+ 	 *
+ 	 * Equal strings among `strs` share a handle; NULL strings get NULL. The block starts
+ 	 * with one reference, dropped by argxcInternRelease().
+ 	 *
+ 	 * @return bool false if memory allocation failed (every handle is then NULL).
+ 	 */
+	bool argxcInternBlock(const char *const strs[], char *handles[], size_t count);
+
+	/**
+ 	 * @brief Record one more holder of the block of `handle`; the first one takes over the
+ 	 * reference of the creator.
+ 	 */
+	void argxcInternAdopt(const char *handle);
+
+	/**
+ 	 * @brief Drop one reference to the block of `handle`, freeing it with the last.
+ 	 */
+	void argxcInternRelease(const char *handle);
+
+	/**
+ 	 * @brief Index of the handles of an arena, created on first use (defined in ARGXArena.c).
+ 	 *
+ 	 * @return struct ArgxcIndex* The index, or NULL if memory allocation failed.
+ 	 */
+	struct ArgxcIndex *argxcArenaStrings(ArgxcArena *arena);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,32 @@
+/* src/ARGXParse.h
+ * Owned and created by: pcannon09
+ * Internal parse entry points, told which `--` tokens end the options
+ */
+
+#pragma once
+
+#include "../inc/ARGXSpec.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+	/**
+ 	 * @brief argxcSpecParseIn() / argxcSpecDispatchIn() (`actions` may be NULL) for a line whose
+ 	 * `--` tokens were not all typed unquoted, e.g. split by argxcTokenize().
+ 	 *
+ 	 * @param endOfOptions Argv position from which a `--` token ends the options: 0 for any
+ 	 * (argv of main()), ArgxcTokens::endOfOptions for a tokenized line, -1 for none.
+ 	 */
+	ArgxcResult *argxcSpecParseLine(ArgxcArena *arena, const ArgxcSpec *spec, int argc, char *const argv[],
+            const ArgxcActionBinding *actions, int endOfOptions);
+
+	/**
+ 	 * @brief argxcResultReparse() with the `endOfOptions` of argxcSpecParseLine().
+ 	 */
+	ArgxcResult *argxcResultReparseLine(ArgxcResult *result, int argc, char *const argv[],
+            const ArgxcActionBinding *actions, int endOfOptions);
+
+#ifdef __cplusplus
+}
+#endif
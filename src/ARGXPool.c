@@ -0,0 +1,252 @@
+/* src/ARGXPool.c
+ * Owned and created by: pcannon09
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#	define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#if defined(_WIN32)
+#	include <windows.h>
+#else
+#	include <pthread.h>
+#	include <unistd.h>
+#endif
+
+#include "../inc/macros.h"
+
+#include "ARGXAtomic.h"
+#include "ARGXPool.h"
+
+// Items a single run can address: a range packs both of its ends in one 64-bit word
+#define ARGX_POOL_MAX_ITEMS 0xffffffffu
+
+// Items left to one worker, packed as begin << 32 | end so a CAS moves either end.
+// Padded to a cache line: each worker polls its own range on every chunk.
+typedef struct {
+    uint64_t range;
+    char padding[64 - sizeof(uint64_t)];
+} ArgxcPoolRange;
+
+typedef struct {
+    ArgxcPoolRange *ranges;
+    size_t workers;
+    size_t chunk;
+    size_t base;           // First item of the current run (see argxcPoolRun)
+    ArgxcPoolWork work;
+    void *context;
+} ArgxcPool;
+
+typedef struct {
+    ArgxcPool *pool;
+    size_t self;
+    bool started;
+#if defined(_WIN32)
+    HANDLE thread;
+#else
+    pthread_t thread;
+#endif
+} ArgxcPoolWorker;
+
+static uint64_t packRange(uint64_t begin, uint64_t end)
+{
+    return begin << 32 | end;
+}
+
+// Take up to `chunk` items from the front of a worker's own range
+static bool takeFront(ArgxcPoolRange *range, size_t chunk, size_t *begin, size_t *end)
+{
+    for (;;)
+	{
+        uint64_t packed = ARGX_ATOMIC_LOAD_ACQUIRE(&range->range);
+        uint64_t first = packed >> 32;
+        uint64_t last = packed & ARGX_POOL_MAX_ITEMS;
+
+        if (first >= last) return false;
+
+        uint64_t taken = last - first > chunk ? first + chunk : last;
+
+        if (ARGX_ATOMIC_CAS(&range->range, packed, packRange(taken, last)))
+		{
+            *begin = (size_t)first;
+            *end = (size_t)taken;
+            return true;
+        }
+    }
+}
+
+// Steal the back half of another worker's range (the last item too)
+static bool stealBack(ArgxcPoolRange *range, size_t *begin, size_t *end)
+{
+    for (;;)
+	{
+        uint64_t packed = ARGX_ATOMIC_LOAD_ACQUIRE(&range->range);
+        uint64_t first = packed >> 32;
+        uint64_t last = packed & ARGX_POOL_MAX_ITEMS;
+
+        if (first >= last) return false;
+
+        uint64_t middle = first + (last - first) / 2;
+
+        if (ARGX_ATOMIC_CAS(&range->range, packed, packRange(first, middle)))
+		{
+            *begin = (size_t)middle;
+            *end = (size_t)last;
+            return true;
+        }
+    }
+}
+
+static void runWorker(ArgxcPool *pool, size_t self)
+{
+    ArgxcPoolRange *own = &pool->ranges[self];
+    size_t begin, end;
+
+    for (;;)
+	{
+        while (takeFront(own, pool->chunk, &begin, &end)) pool->work(pool->context, pool->base + begin, pool->base + end);
+
+        // Out of work: rob the next workers in turn; a full round without loot means
+        // every item is taken (ranges only shrink)
+        bool stolen = false;
+
+        for (size_t k = 1; k < pool->workers && !stolen; k++)
+		{
+            stolen = stealBack(&pool->ranges[(self + k) % pool->workers], &begin, &end);
+        }
+
+        if (!stolen) return;
+
+        // The loot becomes this worker's range, so others can steal from it in turn
+        ARGX_ATOMIC_STORE_RELEASE(&own->range, packRange(begin, end));
+    }
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI workerMain(LPVOID argument)
+{
+    ArgxcPoolWorker *worker = argument;
+    runWorker(worker->pool, worker->self);
+
+    return 0;
+}
+#else
+static void *workerMain(void *argument)
+{
+    ArgxcPoolWorker *worker = argument;
+    runWorker(worker->pool, worker->self);
+
+    return NULL;
+}
+#endif
+
+size_t argxcPoolCpuCount(void)
+{
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+
+    return info.dwNumberOfProcessors > 0 ? (size_t)info.dwNumberOfProcessors : 1;
+#elif defined(_SC_NPROCESSORS_ONLN)
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return cpus > 0 ? (size_t)cpus : 1;
+#else
+    return 1;
+#endif
+}
+
+size_t argxcPoolRun(size_t count, size_t threads, size_t chunk, ArgxcPoolWork work, void *context)
+{
+    if (count == 0 || !work) return 0;
+
+    if (threads == 0) threads = argxcPoolCpuCount();
+    if (threads > ARGX_BATCH_MAX_THREADS) threads = ARGX_BATCH_MAX_THREADS;
+    if (chunk == 0) chunk = 1;
+
+    // No point in more workers than chunks
+    size_t chunks = count / chunk + (count % chunk != 0);
+    if (threads > chunks) threads = chunks;
+
+    ArgxcPoolRange *ranges = NULL;
+    ArgxcPoolWorker *workers = NULL;
+
+    if (threads > 1)
+	{
+        ranges = malloc(threads * sizeof(ArgxcPoolRange));
+        workers = malloc(threads * sizeof(ArgxcPoolWorker));
+
+        if (!ranges || !workers) threads = 1;
+    }
+
+    if (threads <= 1)
+	{
+        free(ranges); ranges = NULL;
+        free(workers); workers = NULL;
+
+        work(context, 0, count);
+        return 1;
+    }
+
+    ArgxcPool pool = {ranges, threads, chunk, 0, work, context};
+    size_t ran = 1;
+
+    for (size_t i = 0; i < threads; i++)
+	{
+        workers[i].pool = &pool;
+        workers[i].self = i;
+        workers[i].started = false;
+    }
+
+    // Runs of at most ARGX_POOL_MAX_ITEMS items, so the ends of each range fit in 32 bits
+    for (pool.base = 0; pool.base < count; pool.base += ARGX_POOL_MAX_ITEMS)
+	{
+        uint64_t items = count - pool.base < ARGX_POOL_MAX_ITEMS ? count - pool.base : ARGX_POOL_MAX_ITEMS;
+
+        for (size_t i = 0; i < threads; i++)
+		{
+            ranges[i].range = packRange(items * i / threads, items * (i + 1) / threads);
+        }
+
+        // Worker 0 is the calling thread
+        for (size_t i = 1; i < threads; i++)
+		{
+#if defined(_WIN32)
+            workers[i].thread = CreateThread(NULL, 0, workerMain, &workers[i], 0, NULL);
+            workers[i].started = workers[i].thread != NULL;
+#else
+            workers[i].started = pthread_create(&workers[i].thread, NULL, workerMain, &workers[i]) == 0;
+#endif
+        }
+
+        runWorker(&pool, 0);
+
+        size_t joined = 1;
+
+        for (size_t i = 1; i < threads; i++)
+		{
+            if (!workers[i].started) continue;
+
+#if defined(_WIN32)
+            WaitForSingleObject(workers[i].thread, INFINITE);
+            CloseHandle(workers[i].thread);
+#else
+            pthread_join(workers[i].thread, NULL);
+#endif
+
+            workers[i].started = false;
+            joined++;
+        }
+
+        if (joined > ran) ran = joined;
+    }
+
+    free(ranges); ranges = NULL;
+    free(workers); workers = NULL;
+
+    return ran;
+}
@@ -0,0 +1,37 @@
+/* src/ARGXPool.h
+ * Owned and created by: pcannon09
+ * Internal thread pool running one index range across workers, with work stealing
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+	// Process items [begin, end); `context` is shared by every worker
+	typedef void (*ArgxcPoolWork)(void *context, size_t begin, size_t end);
+
+	/**
+ 	 * @brief Run `work` over items [0, count) on up to `threads` threads, the caller included.
+ 	 *
+ 	 * Every worker starts with an equal share and takes `chunk` items at a time from its
+ 	 * front; a worker whose share runs out steals the back half of another one's, so the
+ 	 * threads stay busy when items take uneven time. Returns once every item is done.
+ 	 * When a thread cannot be started, the others take over its share.
+ 	 *
+ 	 * @param threads Number of workers (0 for one per online CPU, at most ARGX_BATCH_MAX_THREADS).
+ 	 * @return size_t Number of threads that ran.
+ 	 */
+	size_t argxcPoolRun(size_t count, size_t threads, size_t chunk, ArgxcPoolWork work, void *context);
+
+	/**
+ 	 * @brief Get the number of online CPUs (1 when unknown).
+ 	 */
+	size_t argxcPoolCpuCount(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,309 @@
+/* src/ARGXResponse.c
+ * Owned and created by: pcannon09
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#	define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#ifndef _WIN32
+#	include <fcntl.h>
+#	include <unistd.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#endif
+
+#include "ARGXResponse.h"
+#include "ARGXStats.h"
+
+typedef struct {
+    char **args;
+    size_t count;
+    size_t capacity;
+} ArgxcTokenList;
+
+static bool pushToken(ArgxcTokenList *list, char *token)
+{
+    if (list->count >= list->capacity)
+	{
+        size_t newCapacity = list->capacity == 0 ? 64 : list->capacity * 2;
+        char **args = realloc(list->args, newCapacity * sizeof(char *));
+        if (!args) return false;
+
+        ARGX_STATS_ALLOC(newCapacity * sizeof(char *));
+
+        list->args = args;
+        list->capacity = newCapacity;
+    }
+
+    list->args[list->count++] = token;
+
+    return true;
+}
+
+static bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+// Load a file as a private, writable mapping (copy-on-write: only pages written by
+// the tokenizer are duplicated). Returns false when the file cannot be read.
+static bool loadFile(const char *path, ArgxcResponseMap *map)
+{
+    map->data = NULL;
+    map->size = 0;
+    map->mapped = false;
+
+#ifndef _WIN32
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+	{
+        close(fd);
+        return false;
+    }
+
+    map->size = (size_t)st.st_size;
+
+    if (map->size > 0)
+	{
+        void *data = mmap(NULL, map->size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+
+        if (data == MAP_FAILED)
+		{
+            close(fd);
+            return false;
+        }
+
+        map->data = data;
+        map->mapped = true;
+    }
+
+    close(fd);
+
+    return true;
+#else
+    FILE *file = fopen(path, "rb");
+    if (!file) return false;
+
+    if (fseek(file, 0, SEEK_END) != 0)
+	{
+        fclose(file);
+        return false;
+    }
+
+    long size = ftell(file);
+    rewind(file);
+
+    if (size > 0)
+	{
+        map->data = malloc((size_t)size);
+
+        if (!map->data || fread(map->data, 1, (size_t)size, file) != (size_t)size)
+		{
+            free(map->data); map->data = NULL;
+            fclose(file);
+            return false;
+        }
+
+        ARGX_STATS_ALLOC((size_t)size);
+
+        map->size = (size_t)size;
+    }
+
+    fclose(file);
+
+    return true;
+#endif
+}
+
+static void releaseMap(ArgxcResponseMap *map)
+{
+#ifndef _WIN32
+    if (map->mapped)
+	{
+        munmap(map->data, map->size);
+        return;
+    }
+#endif
+
+    free(map->data);
+}
+
+// A token that ends exactly at end-of-file has no room for its NUL, so it gets a copy
+static char *terminateTail(ArgxcResponseFiles *files, const char *start, size_t len)
+{
+    if (files->tailsCount >= files->tailsCapacity)
+	{
+        size_t newCapacity = files->tailsCapacity == 0 ? 4 : files->tailsCapacity * 2;
+        char **tails = realloc(files->tails, newCapacity * sizeof(char *));
+        if (!tails) return NULL;
+
+        ARGX_STATS_ALLOC(newCapacity * sizeof(char *));
+
+        files->tails = tails;
+        files->tailsCapacity = newCapacity;
+    }
+
+    char *copy = malloc(len + 1);
+    if (!copy) return NULL;
+
+    ARGX_STATS_ALLOC(len + 1);
+
+    memcpy(copy, start, len);
+    copy[len] = '\0';
+    files->tails[files->tailsCount++] = copy;
+
+    return copy;
+}
+
+static bool expandToken(ArgxcResponseFiles *files, ArgxcTokenList *list, char *token, int depth, int maxDepth);
+
+// Split the mapping in place; unquoting only ever shrinks a token, so it fits where it was read
+static bool tokenizeFile(ArgxcResponseFiles *files, ArgxcTokenList *list, char *data, size_t size, int depth, int maxDepth)
+{
+    // An empty file adds no arguments (and was not mapped: `data` is NULL)
+    if (size == 0) return true;
+
+    char *end = data + size;
+    bool nulSeparated = memchr(data, '\0', size) != NULL;
+    char *cursor = data;
+
+    while (cursor < end)
+	{
+        char *start;
+        char *out;
+
+        if (nulSeparated)
+		{
+            start = cursor;
+            out = memchr(cursor, '\0', (size_t)(end - cursor));
+            if (!out) out = end;
+
+            cursor = out + 1;
+        }
+        else
+		{
+            while (cursor < end && isSpace(*cursor)) cursor++;
+            if (cursor >= end) break;
+
+            start = cursor;
+            out = cursor;
+
+            char quote = '\0';
+
+            while (cursor < end && (quote || !isSpace(*cursor)))
+			{
+                char c = *cursor++;
+
+                if (quote)
+				{
+                    if (c == quote) quote = '\0';
+                    else if (c == '\\' && quote == '"' && cursor < end) *out++ = *cursor++;
+                    else *out++ = c;
+                }
+                else if (c == '\'' || c == '"') quote = c;
+                else if (c == '\\' && cursor < end) *out++ = *cursor++;
+                else *out++ = c;
+            }
+
+            if (cursor < end) cursor++; // Step over the separator that receives the NUL
+        }
+
+        char *token = start;
+
+        if (out < end) *out = '\0';
+        else if (!(token = terminateTail(files, start, (size_t)(out - start)))) return false;
+
+        if (!expandToken(files, list, token, depth, maxDepth)) return false;
+    }
+
+    return true;
+}
+
+static bool expandToken(ArgxcResponseFiles *files, ArgxcTokenList *list, char *token, int depth, int maxDepth)
+{
+    if (token[0] != '@' || token[1] == '\0') return pushToken(list, token);
+
+    if (depth >= maxDepth) return false;
+
+    ArgxcResponseMap map;
+    if (!loadFile(token + 1, &map)) return pushToken(list, token); // Not a readable file: keep the argument
+
+    if (files->mapsCount >= files->mapsCapacity)
+	{
+        size_t newCapacity = files->mapsCapacity == 0 ? 4 : files->mapsCapacity * 2;
+        ArgxcResponseMap *maps = realloc(files->maps, newCapacity * sizeof(ArgxcResponseMap));
+
+        if (!maps)
+		{
+            releaseMap(&map);
+            return false;
+        }
+
+        ARGX_STATS_ALLOC(newCapacity * sizeof(ArgxcResponseMap));
+
+        files->maps = maps;
+        files->mapsCapacity = newCapacity;
+    }
+
+    files->maps[files->mapsCount++] = map;
+
+    return tokenizeFile(files, list, map.data, map.size, depth + 1, maxDepth);
+}
+
+bool argxcResponseExpand(ArgxcResponseFiles *files, int argc, char **argv, int maxDepth,
+        char ***outArgs, size_t *outCount)
+{
+    ArgxcTokenList list = {NULL, 0, 0};
+
+    for (int i = 0; i < argc; i++)
+	{
+        bool ok = i == 0 ? pushToken(&list, argv[i]) : expandToken(files, &list, argv[i], 0, maxDepth);
+
+        if (!ok)
+		{
+            free(list.args);
+            return false;
+        }
+    }
+
+    // Keep a valid (non-NULL) array even for an empty command line
+    if (!list.args)
+	{
+        if (!pushToken(&list, NULL)) return false;
+
+        list.count = 0;
+    }
+
+    *outArgs = list.args;
+    *outCount = list.count;
+
+    return true;
+}
+
+void argxcResponseRelease(ArgxcResponseFiles *files)
+{
+    if (!files) return;
+
+    for (size_t i = 0; i < files->mapsCount; i++)
+	{
+        releaseMap(&files->maps[i]);
+    }
+
+    for (size_t i = 0; i < files->tailsCount; i++)
+	{
+        free(files->tails[i]);
+    }
+
+    free(files->maps);
+    free(files->tails);
+    memset(files, 0, sizeof(ArgxcResponseFiles));
+}
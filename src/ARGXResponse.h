@@ -0,0 +1,57 @@
+/* src/ARGXResponse.h
+ * Owned and created by: pcannon09
+ * Internal response-file (@file) expansion
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+	// One loaded response file; tokens point straight into `data`
+	typedef struct {
+    	char *data;
+    	size_t size;
+    	bool mapped;           // true: munmap() on release, false: free()
+	} ArgxcResponseMap;
+
+	typedef struct {
+    	ArgxcResponseMap *maps;
+    	size_t mapsCount;
+    	size_t mapsCapacity;
+    	char **tails;          // Last tokens that ran into end-of-file (copied to get a NUL)
+    	size_t tailsCount;
+    	size_t tailsCapacity;
+	} ArgxcResponseFiles;
+
+	/**
+ 	 * @brief Expand `@path` arguments into the tokens of the referenced files.
+ 	 *
+ 	 * Files are memory-mapped and tokenized in place (whitespace separated with shell-like
+ 	 * quoting and backslash escapes, or NUL separated when the file contains a NUL byte).
+ 	 * Other arguments are borrowed from `argv`. Arguments naming a file that cannot be
+ 	 * opened are kept as-is.
+ 	 *
+ 	 * @param files Receives the mappings backing the tokens.
+ 	 * @param argc Number of arguments.
+ 	 * @param argv Arguments; argv[0] is never expanded.
+ 	 * @param maxDepth Maximum nesting of response files.
+ 	 * @param outArgs Output: heap array of token pointers.
+ 	 * @param outCount Output: number of tokens.
+ 	 * @return false on allocation failure or when nesting exceeds `maxDepth`.
+ 	 */
+	bool argxcResponseExpand(ArgxcResponseFiles *files, int argc, char **argv, int maxDepth,
+            char ***outArgs, size_t *outCount);
+
+	/**
+ 	 * @brief Unmap every file and free the copied tails.
+ 	 */
+	void argxcResponseRelease(ArgxcResponseFiles *files);
+
+#ifdef __cplusplus
+}
+#endif
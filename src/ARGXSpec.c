@@ -0,0 +1,2207 @@
+/* src/ARGXSpec.c
+ * Owned and created by: pcannon09
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#	define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifndef _WIN32
+#	include <fcntl.h>
+#	include <unistd.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#endif
+
+#include "../inc/Argx.h"
+#include "../inc/ARGXSpec.h"
+#include "../inc/macros.h"
+
+#include "ARGXClassify.h"
+#include "ARGXIndex.h"
+#include "ARGXParse.h"
+#include "ARGXStats.h"
+#include "ARGXSuggest.h"
+#include "ARGXValue.h"
+
+#define ARGX_SPEC_NONE UINT32_MAX
+#define ARGX_SPEC_MAGIC "ARGXSPEC"
+#define ARGX_SPEC_BYTE_ORDER 0x01020304u
+#define ARGX_SPEC_TAG_LEN_MAX 0xffffffu
+
+// A compiled spec is a single relocatable image: fixed-size fields, and offsets instead of
+// pointers, so it can be saved as is and used in place from a read-only mapping.
+
+// Node of the flattened option tree.
+// Nodes are numbered breadth-first: top-level options first, in insertion
+// order, followed by their children; the children of a node are contiguous.
+typedef struct {
+    int32_t parent;        // Parent node, -1 for top-level options
+    uint32_t firstChild;   // Index of the first child node
+    uint32_t childCount;
+    uint32_t nameKeys[2];  // Name keys of `param` and `sparam`, ARGX_SPEC_NONE if unset
+    uint32_t wideOffset;   // First presence word in ArgxcResult::wide (more than 64 children only)
+    uint32_t valueSlot;    // Slot in ArgxcResult::values, ARGX_SPEC_NONE without a value
+    uint8_t hasSubParams;
+    uint8_t hasAnySubParams;
+    uint8_t valueType;     // ArgxcValueType
+    uint8_t reserved;
+} ArgxcSpecNode;
+
+// Strings and id chain of a node, kept apart from ArgxcSpecNode so that parsing and presence
+// checks, which only follow keys and links, stream through 32-byte nodes
+typedef struct {
+    uint32_t id;           // Offsets into the string table, ARGX_SPEC_NONE for NULL
+    uint32_t param;
+    uint32_t sparam;
+    uint32_t info;
+    uint32_t nextSameId;   // Next (higher) node sharing this id, ARGX_SPEC_NONE at the end
+} ArgxcSpecText;
+
+// Bucket of the spec's lookup index (the image form of ArgxcIndexEntry): 16 bytes, so a probe
+// reads a single cache line before comparing the string
+typedef struct {
+    uint32_t hash;
+    uint32_t tag;          // Length (saturated to 24 bits) << 8 | kind + 1, 0 marks an empty bucket
+    uint32_t key;          // Offset into the string table
+    uint32_t slot;         // Name key, or node
+} ArgxcSpecEntry;
+
+// Prefix trie over every name; siblings are kept sorted by character, and nodes are stored
+// depth-first so children and siblings always come after the node referring to them
+typedef struct {
+    uint32_t firstChild;   // 0 when none (the root is never a child)
+    uint32_t nextSibling;
+    uint32_t key;          // Name key ending here, ARGX_SPEC_NONE if none
+    uint32_t keysBelow;    // Names ending in this subtree (including here)
+    uint32_t anyKey;       // One name of the subtree (the only one when `keysBelow` is 1)
+    uint32_t c;
+} ArgxcTrieNode;
+
+// Header of a spec image; every section starts at an 8-byte aligned offset from it
+typedef struct {
+    char magic[8];         // ARGX_SPEC_MAGIC, not NUL-terminated
+    uint32_t versionStd;   // ARGX_VERSION_STD of the writer: other versions are rejected
+    uint32_t byteOrder;    // ARGX_SPEC_BYTE_ORDER as stored by the writer
+    uint64_t size;         // Whole image, header included
+    uint32_t headerSize;
+    uint32_t flags;        // ArgxcFlags
+    uint32_t nodesCount;
+    uint32_t optionsCount; // Top-level nodes
+    uint32_t keysCount;
+    uint32_t wideWords;    // Presence words needed by nodes with more than 64 children
+    uint32_t valuesCount;  // Options declaring a value type
+    uint32_t trieCount;
+    uint32_t indexCapacity; // Power of two, with at least one empty bucket
+    uint32_t stringsSize;
+    uint32_t namesSize;    // Ids and names lead the string table; docs follow them
+    uint32_t longestName;  // Of every param/sparam: longer tokens are never hashed
+    uint64_t nodesOffset;
+    uint64_t textsOffset;           // ArgxcSpecText[nodesCount]
+    uint64_t entriesOffset;
+    uint64_t trieOffset;
+    uint64_t keyNamesOffset;        // uint32_t[keysCount]: name of each name key
+    uint64_t keyValueSlotOffset;    // uint32_t[keysCount]: value slot a name feeds
+    uint64_t slotNodesOffset;       // uint32_t[valuesCount]: node of each value slot
+    uint64_t shortKeysOffset;       // uint32_t[256]
+    uint64_t shortTakesValueOffset; // uint8_t[256]
+    uint64_t stringsOffset;
+} ArgxcSpecImage;
+
+// Converted value of one option, filled while parsing
+typedef struct {
+    int position;          // Argv position of the value text, -1 if unset
+    ArgxcValueStatus status;
+    union {
+        int64_t i;
+        uint64_t u;
+        double d;
+        bool b;
+        const char *s;     // Points into argv: never copied
+        size_t e;
+    } as;
+} ArgxcValueSlot;
+
+// Compiled option tree: a handle over its image. Names shared by many options (e.g., a
+// `verbose` sub-option under every command) are stored once as a name key, so each argument
+// updates a single key whatever its fan-out.
+struct ArgxcSpec {
+    const ArgxcSpecImage *image;
+    const ArgxcSpecNode *nodes;
+    const ArgxcSpecText *texts;
+    const ArgxcSpecEntry *entries; // param/sparam -> name key, id -> first node (top-level and
+                                   // first sub-level), (parent, id) -> child node
+    const ArgxcTrieNode *trie;     // Node 0 is the root
+    const uint32_t *keyNames;
+    const uint32_t *keyValueSlot;  // First option declaring the name with a value
+    const uint32_t *slotNodes;
+    const uint32_t *shortKeys;     // Name key of each single-character `-c` name, ARGX_SPEC_NONE if none
+    const uint8_t *shortTakesValue; // The option takes a value or sub-parameters: the rest of a cluster is its value
+    const char *strings;
+    size_t nodesCount;
+    size_t optionsCount;
+    size_t keysCount;
+    size_t wideWords;
+    size_t valuesCount;
+    size_t indexMask;
+    size_t longestName;    // SIZE_MAX when unknown
+    unsigned int flags;
+    void *mapping;         // Loaded file backing the image, NULL otherwise
+    size_t mappingSize;
+    ArgxcArena *arena;     // Source of the spec, NULL for the C heap
+};
+
+// Positions of one argv against a spec; the spec is only read
+struct ArgxcResult {
+    const ArgxcSpec *spec;
+    char *const *argv;
+    size_t argc;
+    int *keyFirstPos;      // First argv position of each name key, -1 if absent
+    int *keyLastPos;       // Last argv position of each name key, -1 if absent
+    uint64_t *wide;        // Backing store for ArgxcParam::subExistsWide
+    ArgxcValueSlot *values;
+    ArgxcTokenInfo *tokens; // Descriptor of each argv token, filled before resolving any
+    size_t ambiguousCount; // Abbreviations matching several names (ARGX_FLAG_ABBREV)
+    uint32_t *path;        // Command path: the node of each command word, outermost first
+    int *pathPos;          // Argv position of each command word
+    size_t depth;
+    size_t depthCapacity;  // Entries of `path` / `pathPos`: the longest line parsed into this block
+    int stopPos;           // Argv position where an action stopped the parse, -1 otherwise
+    int endOfOptions;      // Argv position of the `--` ending the options, -1 if none
+    ArgxcArena *arena;
+};
+
+// Mutable state of a compile; emitted as an image once complete, then freed
+typedef struct {
+    ArgxcSpecNode *nodes;
+    ArgxcSpecText *texts;
+    uint32_t *lastSameId;  // Last node of the id chain headed by each node
+    size_t nodesCount;
+    size_t optionsCount;
+    size_t keysCount;
+    size_t wideWords;
+    size_t valuesCount;
+    char *strings;         // Copies of every string, in node order: ids and names, then docs
+    size_t stringsSize;
+    size_t namesSize;
+    size_t longestName;
+    size_t namesCursor;
+    size_t docsCursor;
+    ArgxcIndex index;      // Keys point into `strings`
+    ArgxcTrieNode *trie;   // In insertion order; reordered depth-first when emitted
+    size_t trieCount;
+    size_t trieCapacity;
+    uint32_t *keyNames;
+    uint32_t *keyValueSlot;
+    uint32_t *slotNodes;
+    uint32_t shortKeys[256];
+    uint8_t shortTakesValue[256];
+} ArgxcSpecBuilder;
+
+static size_t stringSize(const char *str)
+{
+    return str ? strlen(str) + 1 : 0;
+}
+
+static uint32_t copyString(ArgxcSpecBuilder *builder, size_t *cursor, const char *str)
+{
+    if (!str) return ARGX_SPEC_NONE;
+
+    size_t size = strlen(str) + 1;
+    uint32_t offset = (uint32_t)*cursor;
+
+    memcpy(builder->strings + offset, str, size);
+    *cursor += size;
+
+    return offset;
+}
+
+static void measureTree(const ArgxcOptions *options, size_t count, size_t *nodes, size_t *names, size_t *docs)
+{
+    for (size_t i = 0; i < count; i++)
+	{
+        const ArgxcOptions *opt = &options[i];
+
+        *names += stringSize(opt->id) + stringSize(opt->param) + stringSize(opt->sparam);
+        *docs += stringSize(opt->info);
+        measureTree(opt->subParams, opt->subParamsCount, nodes, names, docs);
+    }
+
+    *nodes += count;
+}
+
+static uint32_t findOrAddNameKey(ArgxcSpecBuilder *builder, uint32_t name)
+{
+    const char *str = builder->strings + name;
+    size_t len = 0;
+    uint32_t hash = argxcIndexHash(str, &len);
+    size_t pos = argxcIndexFind(&builder->index, ARGX_INDEX_NAME, str, len, hash);
+
+    if (len > builder->longestName) builder->longestName = len;
+    if (pos != ARGX_INDEX_END) return (uint32_t)builder->index.entries[pos].slot;
+
+    if (!argxcIndexInsertHashed(&builder->index, ARGX_INDEX_NAME, str, len, hash, builder->keysCount))
+        return ARGX_SPEC_NONE;
+
+    return (uint32_t)builder->keysCount++;
+}
+
+// Chain nodes sharing an id in ascending order, so lookups can stop at the first match
+static bool linkIdNode(ArgxcSpecBuilder *builder, uint32_t index)
+{
+    const char *id = builder->strings + builder->texts[index].id;
+    size_t len = 0;
+    uint32_t hash = argxcIndexHash(id, &len);
+    size_t pos = argxcIndexFind(&builder->index, ARGX_INDEX_ID, id, len, hash);
+
+    if (pos == ARGX_INDEX_END)
+	{
+        builder->lastSameId[index] = index;
+        return argxcIndexInsertHashed(&builder->index, ARGX_INDEX_ID, id, len, hash, index);
+    }
+
+    size_t head = builder->index.entries[pos].slot;
+
+    builder->texts[builder->lastSameId[head]].nextSameId = index;
+    builder->lastSameId[head] = index;
+
+    return true;
+}
+
+// Child ids are keyed by (parent, id), so each parent resolves its own children
+static uint32_t childHash(uint32_t idHash, size_t parent)
+{
+    return idHash ^ ((uint32_t)parent * 0x9E3779B1u);
+}
+
+// Names are also keyed by (parent, name), top-level ones with ARGX_SPEC_NONE as parent, so
+// commands and dispatched options resolve against the children of one node at a time
+static bool linkChildName(ArgxcSpecBuilder *builder, uint32_t index, uint32_t name)
+{
+    const char *str = builder->strings + name;
+    size_t len = 0;
+    uint32_t hash = argxcIndexHash(str, &len);
+
+    return argxcIndexInsertHashed(&builder->index, ARGX_INDEX_CHILD_NAME, str, len,
+            childHash(hash, (uint32_t)builder->nodes[index].parent), index);
+}
+
+static bool linkChildNode(ArgxcSpecBuilder *builder, uint32_t index)
+{
+    const char *id = builder->strings + builder->texts[index].id;
+    size_t len = 0;
+    uint32_t hash = argxcIndexHash(id, &len);
+
+    return argxcIndexInsertHashed(&builder->index, ARGX_INDEX_CHILD, id, len,
+            childHash(hash, (size_t)builder->nodes[index].parent), index);
+}
+
+// Copy the strings and flags of one option; children and wide words are set afterwards
+static void fillNode(ArgxcSpecBuilder *builder, size_t index, const char *id, const char *param,
+        const char *sparam, const char *info, bool hasSubParams, bool hasAnySubParams, ArgxcValueType valueType)
+{
+    ArgxcSpecNode *node = &builder->nodes[index];
+    ArgxcSpecText *text = &builder->texts[index];
+
+    text->id = copyString(builder, &builder->namesCursor, id);
+    text->param = copyString(builder, &builder->namesCursor, param);
+    text->sparam = copyString(builder, &builder->namesCursor, sparam);
+    text->info = copyString(builder, &builder->docsCursor, info);
+    text->nextSameId = ARGX_SPEC_NONE;
+    node->hasSubParams = hasSubParams;
+    node->hasAnySubParams = hasAnySubParams;
+    node->valueType = (uint8_t)valueType;
+    node->valueSlot = valueType != ARGX_VALUE_NONE ? (uint32_t)builder->valuesCount++ : ARGX_SPEC_NONE;
+}
+
+// Flatten the option tree breadth-first, copying its strings
+static bool flattenOptions(ArgxcSpecBuilder *builder, const ArgxcOptions *options, size_t optionsCount)
+{
+    // Source option of every node, only needed while flattening
+    const ArgxcOptions **sources = malloc((builder->nodesCount ? builder->nodesCount : 1) * sizeof(ArgxcOptions *));
+    if (!sources) return false;
+
+    ARGX_STATS_ALLOC(builder->nodesCount * sizeof(ArgxcOptions *));
+
+    size_t count = 0;
+
+    for (size_t i = 0; i < optionsCount; i++)
+	{
+        sources[count] = &options[i];
+        builder->nodes[count++].parent = -1;
+    }
+
+    for (size_t i = 0; i < count; i++)
+	{
+        const ArgxcOptions *opt = sources[i];
+        ArgxcSpecNode *node = &builder->nodes[i];
+
+        fillNode(builder, i, opt->id, opt->param, opt->sparam, opt->info,
+                opt->hasSubParams, opt->hasAnySubParams, opt->valueType);
+        node->firstChild = (uint32_t)count;
+        node->childCount = (uint32_t)opt->subParamsCount;
+
+        for (size_t j = 0; j < opt->subParamsCount; j++)
+		{
+            sources[count] = &opt->subParams[j];
+            builder->nodes[count++].parent = (int32_t)i;
+        }
+    }
+
+    free(sources);
+
+    return true;
+}
+
+// A static table is its own breadth-first numbering when top-level options come first and
+// sub-options follow grouped by parent, in parent order: handles are node indices
+static bool flattenStatic(ArgxcSpecBuilder *builder, const ArgxcStaticOption *options, size_t optionsCount)
+{
+    for (size_t i = 0; i < optionsCount; i++)
+	{
+        const ArgxcStaticOption *opt = &options[i];
+        ArgxcSpecNode *node = &builder->nodes[i];
+        int previous = i > 0 ? options[i - 1].parent : -1;
+
+        if (opt->parent < previous || (opt->parent >= 0 && (size_t)opt->parent >= i)) return false;
+
+        fillNode(builder, i, opt->id, opt->param, opt->sparam, opt->info,
+                opt->hasSubParams, opt->hasAnySubParams, opt->valueType);
+        node->parent = opt->parent;
+
+        if (opt->parent < 0)
+		{
+            builder->optionsCount++;
+            continue;
+        }
+
+        ArgxcSpecNode *parent = &builder->nodes[opt->parent];
+        if (parent->childCount++ == 0) parent->firstChild = (uint32_t)i;
+    }
+
+    return true;
+}
+
+// Presence words, name keys, id chains and child links of the flattened nodes
+static bool indexNodes(ArgxcSpecBuilder *builder)
+{
+    for (size_t i = 0; i < builder->nodesCount; i++)
+	{
+        ArgxcSpecNode *node = &builder->nodes[i];
+        uint32_t names[2] = {builder->texts[i].param, builder->texts[i].sparam};
+
+        if (node->childCount > 64)
+		{
+            node->wideOffset = (uint32_t)builder->wideWords;
+            builder->wideWords += (node->childCount + 63) / 64;
+        }
+
+        for (int k = 0; k < 2; k++)
+		{
+            node->nameKeys[k] = ARGX_SPEC_NONE;
+
+            if (names[k] == ARGX_SPEC_NONE) continue;
+
+            node->nameKeys[k] = findOrAddNameKey(builder, names[k]);
+            if (node->nameKeys[k] == ARGX_SPEC_NONE || !linkChildName(builder, (uint32_t)i, names[k])) return false;
+        }
+
+        // Ids are only resolved down to the first sub-level
+        bool withId = node->parent < 0 || builder->nodes[node->parent].parent < 0;
+        bool hasId = builder->texts[i].id != ARGX_SPEC_NONE;
+
+        if (withId && hasId && !linkIdNode(builder, (uint32_t)i)) return false;
+        if (node->parent >= 0 && hasId && !linkChildNode(builder, (uint32_t)i)) return false;
+    }
+
+    return true;
+}
+
+static uint32_t addTrieNode(ArgxcSpecBuilder *builder, unsigned char c)
+{
+    if (builder->trieCount >= builder->trieCapacity)
+	{
+        size_t newCapacity = builder->trieCapacity == 0 ? 64 : builder->trieCapacity * 2;
+        ArgxcTrieNode *trie = realloc(builder->trie, newCapacity * sizeof(ArgxcTrieNode));
+        if (!trie) return ARGX_SPEC_NONE;
+
+        ARGX_STATS_ALLOC(newCapacity * sizeof(ArgxcTrieNode));
+
+        builder->trie = trie;
+        builder->trieCapacity = newCapacity;
+    }
+
+    ArgxcTrieNode *node = &builder->trie[builder->trieCount];
+
+    node->firstChild = 0;
+    node->nextSibling = 0;
+    node->key = ARGX_SPEC_NONE;
+    node->keysBelow = 0;
+    node->anyKey = ARGX_SPEC_NONE;
+    node->c = c;
+
+    return (uint32_t)builder->trieCount++;
+}
+
+// Child of `parent` for `c`, 0 if none
+static uint32_t trieChild(const ArgxcTrieNode *trie, uint32_t parent, unsigned char c)
+{
+    uint32_t child = trie[parent].firstChild;
+
+    while (child && trie[child].c < c) child = trie[child].nextSibling;
+
+    return child && trie[child].c == c ? child : 0;
+}
+
+// Child of `parent` for `c`, created in sorted position if missing; 0 if memory allocation failed
+static uint32_t addTrieChild(ArgxcSpecBuilder *builder, uint32_t parent, unsigned char c)
+{
+    uint32_t prev = 0;
+    uint32_t child = builder->trie[parent].firstChild;
+
+    while (child && builder->trie[child].c < c)
+	{
+        prev = child;
+        child = builder->trie[child].nextSibling;
+    }
+
+    if (child && builder->trie[child].c == c) return child;
+
+    uint32_t added = addTrieNode(builder, c);
+    if (added == ARGX_SPEC_NONE) return 0;
+
+    builder->trie[added].nextSibling = child;
+
+    if (prev) builder->trie[prev].nextSibling = added;
+    else builder->trie[parent].firstChild = added;
+
+    return added;
+}
+
+// Types whose value is required (`--opt value`); booleans only take an attached one
+static bool takesValue(ArgxcValueType type)
+{
+    return type != ARGX_VALUE_NONE && type != ARGX_VALUE_BOOL;
+}
+
+// Dispatch table for POSIX clusters (`-abc`, `-j8`): one lookup per character, mapping it to the
+// first top-level option declaring it (as argxcCompareArgs() does)
+static void buildShortTable(ArgxcSpecBuilder *builder)
+{
+    for (int c = 0; c < 256; c++) builder->shortKeys[c] = ARGX_SPEC_NONE;
+
+    for (size_t i = builder->optionsCount; i-- > 0;)
+	{
+        const ArgxcSpecNode *node = &builder->nodes[i];
+        if (builder->texts[i].sparam == ARGX_SPEC_NONE) continue;
+
+        const char *sparam = builder->strings + builder->texts[i].sparam;
+
+        if (sparam[0] != '-' || sparam[1] == '-' || sparam[1] == '\0' || sparam[2] != '\0') continue;
+
+        unsigned char c = (unsigned char)sparam[1];
+
+        builder->shortKeys[c] = node->nameKeys[1];
+        builder->shortTakesValue[c] = node->hasSubParams || node->hasAnySubParams || takesValue((ArgxcValueType)node->valueType);
+    }
+}
+
+// Map each name to the value slot it feeds: the first option (breadth-first) declaring it with a value
+static bool buildValueTables(ArgxcSpecBuilder *builder)
+{
+    builder->slotNodes = malloc((builder->valuesCount ? builder->valuesCount : 1) * sizeof(uint32_t));
+    builder->keyValueSlot = malloc((builder->keysCount ? builder->keysCount : 1) * sizeof(uint32_t));
+    if (!builder->slotNodes || !builder->keyValueSlot) return false;
+
+    ARGX_STATS_ALLOC(builder->valuesCount * sizeof(uint32_t));
+    ARGX_STATS_ALLOC(builder->keysCount * sizeof(uint32_t));
+
+    for (size_t key = 0; key < builder->keysCount; key++) builder->keyValueSlot[key] = ARGX_SPEC_NONE;
+
+    for (size_t i = 0; i < builder->nodesCount; i++)
+	{
+        const ArgxcSpecNode *node = &builder->nodes[i];
+        if (node->valueSlot == ARGX_SPEC_NONE) continue;
+
+        builder->slotNodes[node->valueSlot] = (uint32_t)i;
+
+        for (int k = 0; k < 2; k++)
+		{
+            uint32_t key = node->nameKeys[k];
+
+            if (key != ARGX_SPEC_NONE && builder->keyValueSlot[key] == ARGX_SPEC_NONE) builder->keyValueSlot[key] = node->valueSlot;
+        }
+    }
+
+    return true;
+}
+
+static bool buildTrie(ArgxcSpecBuilder *builder)
+{
+    builder->keyNames = malloc((builder->keysCount ? builder->keysCount : 1) * sizeof(uint32_t));
+    if (!builder->keyNames || addTrieNode(builder, 0) == ARGX_SPEC_NONE) return false;
+
+    ARGX_STATS_ALLOC(builder->keysCount * sizeof(uint32_t));
+
+    for (size_t i = 0; i < builder->nodesCount; i++)
+	{
+        const ArgxcSpecNode *node = &builder->nodes[i];
+
+        if (node->nameKeys[0] != ARGX_SPEC_NONE) builder->keyNames[node->nameKeys[0]] = builder->texts[i].param;
+        if (node->nameKeys[1] != ARGX_SPEC_NONE) builder->keyNames[node->nameKeys[1]] = builder->texts[i].sparam;
+    }
+
+    for (size_t key = 0; key < builder->keysCount; key++)
+	{
+        uint32_t current = 0;
+
+        builder->trie[0].keysBelow++;
+
+        for (const unsigned char *c = (const unsigned char *)builder->strings + builder->keyNames[key]; *c; c++)
+		{
+            current = addTrieChild(builder, current, *c);
+            if (!current) return false;
+
+            if (builder->trie[current].keysBelow++ == 0) builder->trie[current].anyKey = (uint32_t)key;
+        }
+
+        builder->trie[current].key = (uint32_t)key;
+    }
+
+    return true;
+}
+
+static void freeBuilder(ArgxcSpecBuilder *builder)
+{
+    argxcIndexFree(&builder->index);
+    free(builder->nodes);
+    free(builder->texts);
+    free(builder->lastSameId);
+    free(builder->strings);
+    free(builder->trie);
+    free(builder->keyNames);
+    free(builder->keyValueSlot);
+    free(builder->slotNodes);
+}
+
+// Length and kind of an index key in one word; never 0, which marks an empty bucket
+static uint32_t entryTag(size_t len, ArgxcIndexKind kind)
+{
+    return (uint32_t)(len < ARGX_SPEC_TAG_LEN_MAX ? len : ARGX_SPEC_TAG_LEN_MAX) << 8 | ((uint32_t)kind + 1);
+}
+
+static size_t alignImage(size_t offset)
+{
+    return (offset + 7) & ~(size_t)7;
+}
+
+// Copy the subtree of `index` depth-first; returns its position in `out`
+static uint32_t emitTrie(const ArgxcSpecBuilder *builder, uint32_t index, ArgxcTrieNode *out, uint32_t *count)
+{
+    uint32_t at = (*count)++;
+    uint32_t prev = 0;
+
+    out[at] = builder->trie[index];
+    out[at].firstChild = 0;
+    out[at].nextSibling = 0;
+
+    for (uint32_t child = builder->trie[index].firstChild; child; child = builder->trie[child].nextSibling)
+	{
+        uint32_t copied = emitTrie(builder, child, out, count);
+
+        if (prev) out[prev].nextSibling = copied;
+        else out[at].firstChild = copied;
+
+        prev = copied;
+    }
+
+    return at;
+}
+
+// Point the handle at the sections of an image
+static void attachImage(ArgxcSpec *spec, const ArgxcSpecImage *image)
+{
+    const char *base = (const char *)image;
+
+    spec->image = image;
+    spec->nodes = (const ArgxcSpecNode *)(base + image->nodesOffset);
+    spec->texts = (const ArgxcSpecText *)(base + image->textsOffset);
+    spec->entries = (const ArgxcSpecEntry *)(base + image->entriesOffset);
+    spec->trie = (const ArgxcTrieNode *)(base + image->trieOffset);
+    spec->keyNames = (const uint32_t *)(base + image->keyNamesOffset);
+    spec->keyValueSlot = (const uint32_t *)(base + image->keyValueSlotOffset);
+    spec->slotNodes = (const uint32_t *)(base + image->slotNodesOffset);
+    spec->shortKeys = (const uint32_t *)(base + image->shortKeysOffset);
+    spec->shortTakesValue = (const uint8_t *)(base + image->shortTakesValueOffset);
+    spec->strings = base + image->stringsOffset;
+    spec->nodesCount = image->nodesCount;
+    spec->optionsCount = image->optionsCount;
+    spec->keysCount = image->keysCount;
+    spec->wideWords = image->wideWords;
+    spec->valuesCount = image->valuesCount;
+    spec->indexMask = image->indexCapacity - 1;
+    spec->longestName = image->longestName ? image->longestName : SIZE_MAX;
+    spec->flags = image->flags;
+}
+
+// Lay out the image behind the handle, in a single block
+static ArgxcSpec *emitSpec(ArgxcArena *arena, const ArgxcSpecBuilder *builder, unsigned int flags)
+{
+    size_t capacity = builder->index.capacity ? builder->index.capacity : 1;
+    ArgxcSpecImage header;
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, ARGX_SPEC_MAGIC, sizeof(header.magic));
+    header.versionStd = ARGX_VERSION_STD;
+    header.byteOrder = ARGX_SPEC_BYTE_ORDER;
+    header.headerSize = sizeof(ArgxcSpecImage);
+    header.flags = flags;
+    header.nodesCount = (uint32_t)builder->nodesCount;
+    header.optionsCount = (uint32_t)builder->optionsCount;
+    header.keysCount = (uint32_t)builder->keysCount;
+    header.wideWords = (uint32_t)builder->wideWords;
+    header.valuesCount = (uint32_t)builder->valuesCount;
+    header.trieCount = (uint32_t)builder->trieCount;
+    header.indexCapacity = (uint32_t)capacity;
+    header.stringsSize = (uint32_t)builder->stringsSize;
+    header.namesSize = (uint32_t)builder->namesSize;
+    header.longestName = (uint32_t)builder->longestName;
+
+    size_t offset = alignImage(sizeof(ArgxcSpecImage));
+
+    header.nodesOffset = offset;
+    offset = alignImage(offset + builder->nodesCount * sizeof(ArgxcSpecNode));
+    header.textsOffset = offset;
+    offset = alignImage(offset + builder->nodesCount * sizeof(ArgxcSpecText));
+    header.entriesOffset = offset;
+    offset = alignImage(offset + capacity * sizeof(ArgxcSpecEntry));
+    header.trieOffset = offset;
+    offset = alignImage(offset + builder->trieCount * sizeof(ArgxcTrieNode));
+    header.keyNamesOffset = offset;
+    offset = alignImage(offset + builder->keysCount * sizeof(uint32_t));
+    header.keyValueSlotOffset = offset;
+    offset = alignImage(offset + builder->keysCount * sizeof(uint32_t));
+    header.slotNodesOffset = offset;
+    offset = alignImage(offset + builder->valuesCount * sizeof(uint32_t));
+    header.shortKeysOffset = offset;
+    offset = alignImage(offset + 256 * sizeof(uint32_t));
+    header.shortTakesValueOffset = offset;
+    offset = alignImage(offset + 256);
+    header.stringsOffset = offset;
+    header.size = alignImage(offset + builder->stringsSize);
+
+    // Handle and image share one block
+    size_t imageOffset = alignImage(sizeof(ArgxcSpec));
+    char *block = argxcArenaCalloc(arena, 1, imageOffset + (size_t)header.size);
+    if (!block) return NULL;
+
+    char *image = block + imageOffset;
+
+    memcpy(image, &header, sizeof(header));
+    memcpy(image + header.nodesOffset, builder->nodes, builder->nodesCount * sizeof(ArgxcSpecNode));
+    memcpy(image + header.textsOffset, builder->texts, builder->nodesCount * sizeof(ArgxcSpecText));
+    memcpy(image + header.keyNamesOffset, builder->keyNames, builder->keysCount * sizeof(uint32_t));
+    memcpy(image + header.keyValueSlotOffset, builder->keyValueSlot, builder->keysCount * sizeof(uint32_t));
+    memcpy(image + header.slotNodesOffset, builder->slotNodes, builder->valuesCount * sizeof(uint32_t));
+    memcpy(image + header.shortKeysOffset, builder->shortKeys, sizeof(builder->shortKeys));
+    memcpy(image + header.shortTakesValueOffset, builder->shortTakesValue, sizeof(builder->shortTakesValue));
+    memcpy(image + header.stringsOffset, builder->strings, builder->stringsSize);
+
+    // Buckets keep their positions; keys become string offsets
+    ArgxcSpecEntry *entries = (ArgxcSpecEntry *)(image + header.entriesOffset);
+
+    for (size_t i = 0; i < capacity; i++)
+	{
+        const ArgxcIndexEntry *entry = i < builder->index.capacity ? &builder->index.entries[i] : NULL;
+
+        if (!entry || !entry->key) continue;
+
+        entries[i].hash = entry->hash;
+        entries[i].tag = entryTag(entry->len, entry->kind);
+        entries[i].key = (uint32_t)(entry->key - builder->strings);
+        entries[i].slot = (uint32_t)entry->slot;
+    }
+
+    uint32_t trieCount = 0;
+    emitTrie(builder, 0, (ArgxcTrieNode *)(image + header.trieOffset), &trieCount);
+
+    ArgxcSpec *spec = (ArgxcSpec *)block;
+
+    spec->arena = arena;
+    attachImage(spec, (const ArgxcSpecImage *)image);
+
+    return spec;
+}
+
+// Check that `count` elements of `size` bytes fit at `offset`
+static bool sectionFits(const ArgxcSpecImage *image, uint64_t offset, uint64_t count, size_t size)
+{
+    return offset % 8 == 0 && offset >= image->headerSize && offset <= image->size &&
+        count <= (image->size - offset) / size;
+}
+
+static bool stringFits(const ArgxcSpecImage *image, uint32_t offset, bool optional)
+{
+    return (optional && offset == ARGX_SPEC_NONE) || offset < image->stringsSize;
+}
+
+static bool indexFits(uint32_t index, size_t count, bool optional)
+{
+    return (optional && index == ARGX_SPEC_NONE) || index < count;
+}
+
+// Reject stale or damaged images: every offset and index is checked once here, so queries
+// never need to. Links only point forward (or, for ids, up the tree), which also rules out cycles.
+static bool validateImage(const void *data, size_t size)
+{
+    const ArgxcSpecImage *image = data;
+
+    if (((uintptr_t)data & 7) != 0 || size < sizeof(ArgxcSpecImage)) return false;
+
+    if (memcmp(image->magic, ARGX_SPEC_MAGIC, sizeof(image->magic)) != 0 || image->versionStd != ARGX_VERSION_STD ||
+            image->byteOrder != ARGX_SPEC_BYTE_ORDER || image->headerSize != sizeof(ArgxcSpecImage) || image->size != size)
+        return false;
+
+    size_t capacity = image->indexCapacity;
+
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0 || image->trieCount == 0 || image->optionsCount > image->nodesCount ||
+            image->namesSize > image->stringsSize)
+        return false;
+
+    if (!sectionFits(image, image->nodesOffset, image->nodesCount, sizeof(ArgxcSpecNode)) ||
+            !sectionFits(image, image->textsOffset, image->nodesCount, sizeof(ArgxcSpecText)) ||
+            !sectionFits(image, image->entriesOffset, capacity, sizeof(ArgxcSpecEntry)) ||
+            !sectionFits(image, image->trieOffset, image->trieCount, sizeof(ArgxcTrieNode)) ||
+            !sectionFits(image, image->keyNamesOffset, image->keysCount, sizeof(uint32_t)) ||
+            !sectionFits(image, image->keyValueSlotOffset, image->keysCount, sizeof(uint32_t)) ||
+            !sectionFits(image, image->slotNodesOffset, image->valuesCount, sizeof(uint32_t)) ||
+            !sectionFits(image, image->shortKeysOffset, 256, sizeof(uint32_t)) ||
+            !sectionFits(image, image->shortTakesValueOffset, 256, 1) ||
+            !sectionFits(image, image->stringsOffset, image->stringsSize, 1))
+        return false;
+
+    ArgxcSpec spec;
+
+    attachImage(&spec, image);
+
+    // Every string offset must land before a NUL
+    if (image->stringsSize > 0 && spec.strings[image->stringsSize - 1] != '\0') return false;
+
+    // Results size their presence words from the header: it must match the nodes
+    size_t wideWords = 0;
+
+    for (size_t i = 0; i < spec.nodesCount; i++)
+	{
+        const ArgxcSpecNode *node = &spec.nodes[i];
+        const ArgxcSpecText *text = &spec.texts[i];
+
+        if (!stringFits(image, text->id, true) || !stringFits(image, text->param, true) ||
+                !stringFits(image, text->sparam, true) || !stringFits(image, text->info, true))
+            return false;
+
+        if (i < spec.optionsCount ? node->parent != -1 : (node->parent < 0 || (size_t)node->parent >= i)) return false;
+
+        if (node->childCount > 0 && (node->firstChild <= i || node->firstChild > spec.nodesCount ||
+                    node->childCount > spec.nodesCount - node->firstChild))
+            return false;
+
+        if (node->childCount > 64 && (node->wideOffset > spec.wideWords ||
+                    (node->childCount + 63) / 64 > spec.wideWords - node->wideOffset))
+            return false;
+
+        if (node->childCount > 64) wideWords += (node->childCount + 63) / 64;
+
+        if (!indexFits(node->nameKeys[0], spec.keysCount, true) || !indexFits(node->nameKeys[1], spec.keysCount, true))
+            return false;
+
+        if (text->nextSameId != ARGX_SPEC_NONE && (text->nextSameId <= i || text->nextSameId >= spec.nodesCount))
+            return false;
+
+        if (node->valueType > ARGX_VALUE_ENUM ||
+                (node->valueType == ARGX_VALUE_NONE) != (node->valueSlot == ARGX_SPEC_NONE) ||
+                !indexFits(node->valueSlot, spec.valuesCount, true))
+            return false;
+    }
+
+    if (wideWords != spec.wideWords) return false;
+
+    // Probe sequences stop at an empty bucket
+    bool hasEmpty = false;
+
+    for (size_t i = 0; i < capacity; i++)
+	{
+        const ArgxcSpecEntry *entry = &spec.entries[i];
+
+        if (entry->tag == 0)
+		{
+            hasEmpty = true;
+            continue;
+        }
+
+        uint32_t kind = (entry->tag & 0xff) - 1;
+        uint32_t len = entry->tag >> 8;
+
+        // Saturated lengths are measured on the string, which the NUL at the end bounds
+        if (entry->key >= image->stringsSize || (len < ARGX_SPEC_TAG_LEN_MAX && len >= image->stringsSize - entry->key) ||
+                kind > ARGX_INDEX_CHILD_NAME)
+            return false;
+
+        if (!indexFits(entry->slot, kind == ARGX_INDEX_NAME ? spec.keysCount : spec.nodesCount, false)) return false;
+    }
+
+    if (!hasEmpty) return false;
+
+    for (size_t i = 0; i < image->trieCount; i++)
+	{
+        const ArgxcTrieNode *node = &spec.trie[i];
+
+        if ((node->firstChild && (node->firstChild <= i || node->firstChild >= image->trieCount)) ||
+                (node->nextSibling && (node->nextSibling <= i || node->nextSibling >= image->trieCount)) ||
+                !indexFits(node->key, spec.keysCount, true) || !indexFits(node->anyKey, spec.keysCount, true) || node->c > 255)
+            return false;
+    }
+
+    for (size_t key = 0; key < spec.keysCount; key++)
+	{
+        if (!stringFits(image, spec.keyNames[key], false) || !indexFits(spec.keyValueSlot[key], spec.valuesCount, true))
+            return false;
+    }
+
+    for (size_t slot = 0; slot < spec.valuesCount; slot++)
+	{
+        if (!indexFits(spec.slotNodes[slot], spec.nodesCount, false)) return false;
+    }
+
+    for (int c = 0; c < 256; c++)
+	{
+        if (!indexFits(spec.shortKeys[c], spec.keysCount, true)) return false;
+    }
+
+    return true;
+}
+
+static bool entryMatches(const ArgxcSpec *spec, const ArgxcSpecEntry *entry, uint32_t hash, uint32_t tag,
+        const char *key, size_t len)
+{
+    ARGX_STATS_ADD(hashProbes, 1);
+
+    if (entry->hash != hash || entry->tag != tag) return false;
+    if (len >= ARGX_SPEC_TAG_LEN_MAX && strlen(spec->strings + entry->key) != len) return false;
+
+    ARGX_STATS_ADD(stringCompares, 1);
+
+    return memcmp(spec->strings + entry->key, key, len) == 0;
+}
+
+// Lookups on the image index, as argxcIndexFind() / argxcIndexNext() do on an ArgxcIndex
+static size_t specNext(const ArgxcSpec *spec, size_t pos, ArgxcIndexKind kind, const char *key, size_t len, uint32_t hash)
+{
+    size_t mask = spec->indexMask;
+    uint32_t tag = entryTag(len, kind);
+
+    for (pos = (pos + 1) & mask; spec->entries[pos].tag != 0; pos = (pos + 1) & mask)
+	{
+        if (entryMatches(spec, &spec->entries[pos], hash, tag, key, len)) return pos;
+    }
+
+    return ARGX_INDEX_END;
+}
+
+static size_t specFind(const ArgxcSpec *spec, ArgxcIndexKind kind, const char *key, size_t len, uint32_t hash)
+{
+    size_t mask = spec->indexMask;
+    uint32_t tag = entryTag(len, kind);
+
+    for (size_t pos = hash & mask; spec->entries[pos].tag != 0; pos = (pos + 1) & mask)
+	{
+        if (entryMatches(spec, &spec->entries[pos], hash, tag, key, len)) return pos;
+    }
+
+    return ARGX_INDEX_END;
+}
+
+// Trie node reached by `prefix`, 0 if no name starts with it (or if `prefix` is empty)
+static uint32_t trieFind(const ArgxcSpec *spec, const char *prefix, size_t len)
+{
+    uint32_t current = 0;
+
+    for (size_t i = 0; i < len; i++)
+	{
+        current = trieChild(spec->trie, current, (unsigned char)prefix[i]);
+        if (!current) return 0;
+    }
+
+    return current;
+}
+
+// Abbreviations are GNU-style: only `--name` tokens, never `-x` or sub-option words
+static bool isAbbreviable(const char *arg, size_t len)
+{
+    return len > 2 && arg[0] == '-' && arg[1] == '-';
+}
+
+// Name key of `name` (its first `len` bytes), or of the only long name it abbreviates;
+// `matches` receives the number of names it could stand for
+static size_t resolveName(const ArgxcSpec *spec, const char *name, size_t len, uint32_t hash, bool abbrev, int *matches)
+{
+    size_t pos = specFind(spec, ARGX_INDEX_NAME, name, len, hash);
+
+    *matches = pos != ARGX_INDEX_END;
+
+    if (pos != ARGX_INDEX_END) return spec->entries[pos].slot;
+    if (!abbrev || !isAbbreviable(name, len)) return ARGX_INDEX_END;
+
+    // Only tokens that are not a full name walk the trie
+    uint32_t node = trieFind(spec, name, len);
+    if (!node) return ARGX_INDEX_END;
+
+    *matches = (int)spec->trie[node].keysBelow;
+
+    return spec->trie[node].keysBelow == 1 ? spec->trie[node].anyKey : ARGX_INDEX_END;
+}
+
+// Resolve a whole token described by `info`, splitting `--name=value` (or `name=value` for a
+// sub-option word) for options that take a value. Tokens longer than every name match none,
+// not even as an abbreviation.
+static size_t resolveToken(const ArgxcSpec *spec, const char *arg, const ArgxcTokenInfo *info, bool abbrev,
+        const char **value, int *matches)
+{
+    *value = NULL;
+    *matches = 0;
+
+    size_t key = info->hashed ? resolveName(spec, arg, info->length, info->hash, abbrev, matches) : ARGX_INDEX_END;
+    if (key != ARGX_INDEX_END || *matches > 1) return key;
+    if (info->kind == ARGX_TOKEN_DASH || info->kind == ARGX_TOKEN_END_OF_OPTIONS) return key;
+
+    // The name needs a character besides its dash
+    size_t nameLen = info->split;
+    size_t minLen = info->kind == ARGX_TOKEN_WORD ? 1 : 2;
+    if (nameLen == info->length || nameLen < minLen || nameLen > spec->longestName) return ARGX_INDEX_END;
+
+    key = resolveName(spec, arg, nameLen, argxcIndexHashBytes(arg, nameLen), abbrev, matches);
+    if (key == ARGX_INDEX_END) return key;
+
+    if (spec->keyValueSlot[key] == ARGX_SPEC_NONE)
+	{
+        *matches = 0;
+        return ARGX_INDEX_END;
+    }
+
+    *value = arg + nameLen + 1;
+
+    return key;
+}
+
+// Allocate the node and string buffers of a compile; false if memory allocation failed
+static bool startBuilder(ArgxcSpecBuilder *builder)
+{
+    // Every reference in the image is 32-bit
+    if (builder->nodesCount >= ARGX_SPEC_NONE || builder->stringsSize >= ARGX_SPEC_NONE) return false;
+
+    size_t nodes = builder->nodesCount ? builder->nodesCount : 1;
+
+    builder->nodes = calloc(nodes, sizeof(ArgxcSpecNode));
+    builder->texts = calloc(nodes, sizeof(ArgxcSpecText));
+    builder->lastSameId = malloc(nodes * sizeof(uint32_t));
+    builder->strings = malloc(builder->stringsSize ? builder->stringsSize : 1);
+    builder->docsCursor = builder->namesSize;
+    ARGX_STATS_ALLOC(builder->nodesCount * (sizeof(ArgxcSpecNode) + sizeof(ArgxcSpecText) + sizeof(uint32_t)));
+    ARGX_STATS_ALLOC(builder->stringsSize);
+
+    return builder->nodes && builder->texts && builder->lastSameId && builder->strings;
+}
+
+// Build the lookup tables of flattened nodes and emit the spec; frees the builder
+static ArgxcSpec *finishBuilder(ArgxcArena *arena, ArgxcSpecBuilder *builder, bool flattened, unsigned int flags)
+{
+    ArgxcSpec *spec = NULL;
+
+    if (flattened && indexNodes(builder) && buildTrie(builder) && buildValueTables(builder))
+	{
+        buildShortTable(builder);
+        spec = emitSpec(arena, builder, flags);
+    }
+
+    freeBuilder(builder);
+
+    return spec;
+}
+
+ArgxcSpec *argxcSpecCreateIn(ArgxcArena *arena, const ArgxcOptions *options, size_t optionsCount, unsigned int flags)
+{
+    if (!options && optionsCount > 0) return NULL;
+
+    ARGX_TRACE_BEGIN(ARGX_TRACE_SPEC_CREATE);
+
+    ArgxcSpecBuilder builder;
+    memset(&builder, 0, sizeof(builder));
+
+    size_t docsSize = 0;
+
+    measureTree(options, optionsCount, &builder.nodesCount, &builder.namesSize, &docsSize);
+    builder.stringsSize = builder.namesSize + docsSize;
+    builder.optionsCount = optionsCount;
+
+    bool flattened = startBuilder(&builder) && flattenOptions(&builder, options, optionsCount);
+    ArgxcSpec *spec = finishBuilder(arena, &builder, flattened, flags);
+
+    ARGX_TRACE_END(ARGX_TRACE_SPEC_CREATE);
+
+    return spec;
+}
+
+ArgxcSpec *argxcSpecCreate(const ArgxcOptions *options, size_t optionsCount, unsigned int flags)
+{
+    return argxcSpecCreateIn(NULL, options, optionsCount, flags);
+}
+
+ArgxcSpec *argxcSpecCreateStaticIn(ArgxcArena *arena, const ArgxcStaticOption *options, size_t optionsCount, unsigned int flags)
+{
+    if (!options && optionsCount > 0) return NULL;
+
+    ARGX_TRACE_BEGIN(ARGX_TRACE_SPEC_CREATE);
+
+    ArgxcSpecBuilder builder;
+    memset(&builder, 0, sizeof(builder));
+
+    builder.nodesCount = optionsCount;
+
+    for (size_t i = 0; i < optionsCount; i++)
+	{
+        builder.namesSize += stringSize(options[i].id) + stringSize(options[i].param) + stringSize(options[i].sparam);
+        builder.stringsSize += stringSize(options[i].info);
+    }
+
+    builder.stringsSize += builder.namesSize;
+
+    bool flattened = startBuilder(&builder) && flattenStatic(&builder, options, optionsCount);
+    ArgxcSpec *spec = finishBuilder(arena, &builder, flattened, flags);
+
+    ARGX_TRACE_END(ARGX_TRACE_SPEC_CREATE);
+
+    return spec;
+}
+
+ArgxcSpec *argxcSpecCreateStatic(const ArgxcStaticOption *options, size_t optionsCount, unsigned int flags)
+{
+    return argxcSpecCreateStaticIn(NULL, options, optionsCount, flags);
+}
+
+// Map a saved image read-only (read into the heap on Windows); NULL if the file cannot be read
+static void *mapImage(const char *path, size_t *size)
+{
+#ifndef _WIN32
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+
+    struct stat st;
+    void *data = NULL;
+
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+	{
+        data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (data == MAP_FAILED) data = NULL;
+        else *size = (size_t)st.st_size;
+    }
+
+    close(fd);
+
+    return data;
+#else
+    FILE *file = fopen(path, "rb");
+    if (!file) return NULL;
+
+    if (fseek(file, 0, SEEK_END) != 0)
+	{
+        fclose(file);
+        return NULL;
+    }
+
+    long fileSize = ftell(file);
+    void *data = fileSize > 0 ? malloc((size_t)fileSize) : NULL;
+
+    rewind(file);
+
+    if (data && fread(data, 1, (size_t)fileSize, file) != (size_t)fileSize)
+	{
+        free(data); data = NULL;
+    }
+
+    fclose(file);
+
+    if (data) *size = (size_t)fileSize;
+
+    return data;
+#endif
+}
+
+static void unmapImage(void *data, size_t size)
+{
+#ifndef _WIN32
+    munmap(data, size);
+#else
+    (void)size;
+    free(data);
+#endif
+}
+
+bool argxcSpecSave(const ArgxcSpec *spec, const char *path)
+{
+    if (!spec || !path) return false;
+
+    FILE *file = fopen(path, "wb");
+    if (!file) return false;
+
+    size_t size = (size_t)spec->image->size;
+    bool ok = fwrite(spec->image, 1, size, file) == size;
+
+    if (fclose(file) != 0) ok = false;
+
+    // Never leave a truncated image behind
+    if (!ok) remove(path);
+
+    return ok;
+}
+
+const void *argxcSpecGetImage(const ArgxcSpec *spec, size_t *size)
+{
+    if (size) *size = spec ? (size_t)spec->image->size : 0;
+
+    return spec ? spec->image : NULL;
+}
+
+ArgxcSpec *argxcSpecLoadImage(const void *data, size_t size)
+{
+    if (!data || !validateImage(data, size)) return NULL;
+
+    ArgxcSpec *spec = calloc(1, sizeof(ArgxcSpec));
+    if (!spec) return NULL;
+
+    attachImage(spec, data);
+
+    return spec;
+}
+
+ArgxcSpec *argxcSpecLoad(const char *path)
+{
+    if (!path) return NULL;
+
+    size_t size = 0;
+    void *data = mapImage(path, &size);
+    if (!data) return NULL;
+
+    ArgxcSpec *spec = argxcSpecLoadImage(data, size);
+
+    if (!spec)
+	{
+        unmapImage(data, size);
+        return NULL;
+    }
+
+    spec->mapping = data;
+    spec->mappingSize = size;
+
+    return spec;
+}
+
+void argxcSpecDestroy(ArgxcSpec *spec)
+{
+    if (!spec) return;
+
+    if (spec->mapping) unmapImage(spec->mapping, spec->mappingSize);
+
+    argxcArenaFree(spec->arena, spec);
+}
+
+size_t argxcSpecGetOptionsCount(const ArgxcSpec *spec)
+{
+    return spec ? spec->optionsCount : 0;
+}
+
+size_t argxcSpecGetNodesCount(const ArgxcSpec *spec)
+{
+    return spec ? spec->nodesCount : 0;
+}
+
+unsigned int argxcSpecGetFlags(const ArgxcSpec *spec)
+{
+    return spec ? spec->flags : 0;
+}
+
+// Depth-first walk in character order, so names come out sorted
+static void collectNames(const ArgxcSpec *spec, uint32_t index, const char **names, size_t max, size_t *found)
+{
+    const ArgxcTrieNode *node = &spec->trie[index];
+
+    if (node->key != ARGX_SPEC_NONE)
+	{
+        if (names && *found < max) names[*found] = spec->strings + spec->keyNames[node->key];
+        (*found)++;
+    }
+
+    // Subtrees past the output buffer only need counting
+    for (uint32_t child = node->firstChild; child; child = spec->trie[child].nextSibling)
+	{
+        if (names && *found >= max) *found += spec->trie[child].keysBelow;
+        else collectNames(spec, child, names, max, found);
+    }
+}
+
+size_t argxcSpecComplete(const ArgxcSpec *spec, const char *prefix, const char **names, size_t max)
+{
+    if (!spec || !prefix) return 0;
+
+    uint32_t node = trieFind(spec, prefix, strlen(prefix));
+    if (!node && prefix[0] != '\0') return 0;
+    if (!names) return spec->trie[node].keysBelow;
+
+    size_t found = 0;
+    collectNames(spec, node, names, max, &found);
+
+    return found;
+}
+
+size_t argxcSpecSuggest(const ArgxcSpec *spec, const char *token, const char **names, size_t max)
+{
+    if (!spec || !token || !names) return 0;
+
+    ArgxcSuggest suggest;
+    if (!argxcSuggestInit(&suggest, token, max)) return 0;
+
+    // Name keys are the distinct names, numbered in node order
+    for (size_t key = 0; key < spec->keysCount; key++) argxcSuggestOffer(&suggest, spec->strings + spec->keyNames[key]);
+
+    return argxcSuggestFinish(&suggest, names);
+}
+
+int argxcSpecResolveAbbrev(const ArgxcSpec *spec, const char *arg, const char **name)
+{
+    if (name) *name = NULL;
+    if (!spec || !arg) return 0;
+
+    ArgxcTokenInfo info;
+    const char *value = NULL;
+    int matches = 0;
+
+    argxcClassifyToken(arg, spec->longestName, &info);
+
+    size_t key = resolveToken(spec, arg, &info, true, &value, &matches);
+
+    if (name && key != ARGX_INDEX_END) *name = spec->strings + spec->keyNames[key];
+
+    return matches;
+}
+
+// Child of `parent` (ARGX_SPEC_NONE for the top level) named `name`
+static size_t findChildName(const ArgxcSpec *spec, uint32_t parent, const char *name, size_t len, uint32_t hash)
+{
+    hash = childHash(hash, parent);
+
+    for (size_t pos = specFind(spec, ARGX_INDEX_CHILD_NAME, name, len, hash);
+            pos != ARGX_INDEX_END; pos = specNext(spec, pos, ARGX_INDEX_CHILD_NAME, name, len, hash))
+	{
+        size_t index = spec->entries[pos].slot;
+
+        if ((uint32_t)spec->nodes[index].parent == parent) return index;
+    }
+
+    return ARGX_INDEX_END;
+}
+
+static void markKey(ArgxcResult *result, size_t key, size_t position)
+{
+    if (result->keyFirstPos[key] < 0) result->keyFirstPos[key] = (int)position;
+    result->keyLastPos[key] = (int)position;
+}
+
+// Number of leading cluster characters that are short options: the whole cluster, or up
+// to the first option taking a value (which consumes the rest); 0 if the token is not a cluster
+static size_t matchCluster(const ArgxcSpec *spec, const char *arg, const ArgxcTokenInfo *info)
+{
+    if (info->kind != ARGX_TOKEN_SHORT) return 0;
+
+    for (size_t i = 1; i < info->length; i++)
+	{
+        unsigned char c = (unsigned char)arg[i];
+
+        if (spec->shortKeys[c] == ARGX_SPEC_NONE) return 0;
+        if (spec->shortTakesValue[c]) return i;
+    }
+
+    return info->length - 1;
+}
+
+// Position of the sub-option of `node` named `text`
+static bool findEnumValue(const ArgxcSpec *spec, const ArgxcSpecNode *node, const char *text, size_t *index)
+{
+    size_t len = 0;
+    uint32_t hash = argxcIndexHash(text, &len);
+    size_t pos = specFind(spec, ARGX_INDEX_NAME, text, len, hash);
+
+    if (pos == ARGX_INDEX_END) return false;
+
+    size_t key = spec->entries[pos].slot;
+
+    for (size_t j = 0; j < node->childCount; j++)
+	{
+        const ArgxcSpecNode *child = &spec->nodes[node->firstChild + j];
+
+        if (child->nameKeys[0] == key || child->nameKeys[1] == key)
+		{
+            *index = j;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Convert `text` once, so getters only read the slot
+static void convertValue(const ArgxcSpec *spec, const ArgxcSpecNode *node, ArgxcValueSlot *slot,
+        const char *text, size_t position)
+{
+    bool ok = false;
+
+    switch (node->valueType)
+	{
+        case ARGX_VALUE_INT64: ok = argxcValueParseInt64(text, &slot->as.i); break;
+        case ARGX_VALUE_UINT64: ok = argxcValueParseUint64(text, &slot->as.u); break;
+        case ARGX_VALUE_DOUBLE: ok = argxcValueParseDouble(text, &slot->as.d); break;
+        case ARGX_VALUE_BOOL: ok = argxcValueParseBool(text, &slot->as.b); break;
+        case ARGX_VALUE_STRING: slot->as.s = text; ok = true; break;
+        case ARGX_VALUE_ENUM: ok = findEnumValue(spec, node, text, &slot->as.e); break;
+        default: break;
+    }
+
+    slot->status = ok ? ARGX_VALUE_OK : ARGX_VALUE_INVALID;
+    slot->position = (int)position;
+}
+
+// Store the value of `key` (attached, or the next token); returns the last argv position consumed
+static size_t storeValue(ArgxcResult *result, size_t key, const char *attached, size_t k)
+{
+    const ArgxcSpec *spec = result->spec;
+    uint32_t index = spec->keyValueSlot[key];
+
+    if (index == ARGX_SPEC_NONE) return k;
+
+    const ArgxcSpecNode *node = &spec->nodes[spec->slotNodes[index]];
+    ArgxcValueSlot *slot = &result->values[index];
+
+    if (attached)
+	{
+        convertValue(spec, node, slot, attached, k);
+        return k;
+    }
+
+    if (node->valueType == ARGX_VALUE_BOOL)
+	{
+        slot->status = ARGX_VALUE_OK;
+        slot->as.b = true;
+        slot->position = (int)k;
+        return k;
+    }
+
+    if (k + 1 >= result->argc || !result->argv[k + 1])
+	{
+        slot->status = ARGX_VALUE_MISSING;
+        slot->position = (int)k;
+        return k;
+    }
+
+    convertValue(spec, node, slot, result->argv[k + 1], k + 1);
+
+    // Enum values are sub-option names: leave them to be matched as such
+    return node->valueType == ARGX_VALUE_ENUM ? k : k + 1;
+}
+
+// Node a dispatched name stands for: a child of the last option with sub-options, then of
+// the commands (deepest first), then a top-level option; ARGX_INDEX_END if none.
+// `arg` (NULL for clusters and `--name=value`) saves hashing the name when it is the token itself.
+static size_t scopedNode(const ArgxcResult *result, uint32_t scope, size_t key, const char *arg, size_t argLen, uint32_t argHash)
+{
+    const ArgxcSpec *spec = result->spec;
+    const char *name = spec->strings + spec->keyNames[key];
+    size_t len = argLen;
+    uint32_t hash = argHash;
+
+    if (!arg || strncmp(name, arg, argLen) != 0 || name[argLen] != '\0') hash = argxcIndexHash(name, &len);
+
+    size_t index = scope != ARGX_SPEC_NONE ? findChildName(spec, scope, name, len, hash) : ARGX_INDEX_END;
+
+    for (size_t d = result->depth; index == ARGX_INDEX_END && d-- > 0;)
+	{
+        index = findChildName(spec, result->path[d], name, len, hash);
+    }
+
+    return index != ARGX_INDEX_END ? index : findChildName(spec, ARGX_SPEC_NONE, name, len, hash);
+}
+
+// Text of the value stored for `key` at argv position `k` (never copied), NULL if none
+static const char *valueText(const ArgxcResult *result, size_t key, const char *attached, size_t k)
+{
+    if (attached) return attached;
+
+    uint32_t index = result->spec->keyValueSlot[key];
+    if (index == ARGX_SPEC_NONE) return NULL;
+
+    int position = result->values[index].position;
+
+    return position > (int)k ? result->argv[position] : NULL;
+}
+
+// Run the action of the node a token stands for (`command` when it is a command word; `arg`,
+// `len` and `hash` describe the whole token, see scopedNode()); false if the action asks to stop
+static bool dispatchToken(const ArgxcResult *result, const ArgxcActionBinding *actions, size_t command, size_t key,
+        const char *arg, size_t len, uint32_t hash, const char *attached, size_t k, uint32_t *scope)
+{
+    const ArgxcSpec *spec = result->spec;
+    size_t index = command != ARGX_INDEX_END ? command : scopedNode(result, *scope, key, arg, len, hash);
+
+    if (index == ARGX_INDEX_END) return true;
+
+    const ArgxcSpecNode *node = &spec->nodes[index];
+    const ArgxcActionBinding *binding = &actions[index];
+    uint32_t id = spec->texts[index].id;
+
+    if (node->childCount > 0) *scope = (uint32_t)index;
+    if (!binding->action) return true;
+
+    return binding->action(binding->userData, id != ARGX_SPEC_NONE ? spec->strings + id : NULL,
+            index, (int)k, valueText(result, key, attached, k));
+}
+
+// Size of a result block holding `depthCapacity` tokens and command words; when `block` is given,
+// point the arrays of its result into it
+static size_t layoutResult(const ArgxcSpec *spec, size_t depthCapacity, char *block)
+{
+    size_t keys = spec->keysCount;
+    size_t wideOffset = (sizeof(ArgxcResult) + sizeof(uint64_t) - 1) / sizeof(uint64_t) * sizeof(uint64_t);
+    size_t valuesOffset = wideOffset + spec->wideWords * sizeof(uint64_t);
+    size_t tokensOffset = valuesOffset + spec->valuesCount * sizeof(ArgxcValueSlot);
+    size_t positionsOffset = tokensOffset + depthCapacity * sizeof(ArgxcTokenInfo);
+    size_t pathOffset = positionsOffset + keys * 2 * sizeof(int);
+
+    if (block)
+	{
+        ArgxcResult *result = (ArgxcResult *)block;
+
+        result->wide = (uint64_t *)(block + wideOffset);
+        result->values = (ArgxcValueSlot *)(block + valuesOffset);
+        result->tokens = (ArgxcTokenInfo *)(block + tokensOffset);
+        result->keyFirstPos = (int *)(block + positionsOffset);
+        result->keyLastPos = result->keyFirstPos + keys;
+        result->path = (uint32_t *)(block + pathOffset);
+        result->pathPos = (int *)(result->path + depthCapacity);
+        result->depthCapacity = depthCapacity;
+    }
+
+    return pathOffset + depthCapacity * (sizeof(uint32_t) + sizeof(int));
+}
+
+static void fillWide(ArgxcResult *result);
+
+// Scan one command line into a laid out result, overwriting what it held;
+// `actions` may be NULL. Shared by every parse and argxcResultReparse().
+static void scanLine(ArgxcResult *result, int argc, char *const argv[], const ArgxcActionBinding *actions,
+        int endOfOptions)
+{
+    const ArgxcSpec *spec = result->spec;
+    size_t keys = spec->keysCount;
+
+    ARGX_TRACE_BEGIN(ARGX_TRACE_SPEC_PARSE);
+
+    result->argv = argv;
+    result->argc = argc > 0 ? (size_t)argc : 0;
+    result->ambiguousCount = 0;
+    result->depth = 0;
+    result->stopPos = -1;
+    result->endOfOptions = -1;
+
+    for (size_t i = 0; i < keys; i++)
+	{
+        result->keyFirstPos[i] = -1;
+        result->keyLastPos[i] = -1;
+    }
+
+    for (size_t i = 0; i < spec->valuesCount; i++)
+	{
+        result->values[i].status = ARGX_VALUE_UNSET;
+        result->values[i].position = -1;
+    }
+
+    bool abbrev = (spec->flags & ARGX_FLAG_ABBREV) != 0;
+    bool stopped = false;
+    uint32_t scope = ARGX_SPEC_NONE; // Last dispatched option with sub-options
+
+    // Classify every token first (length, `=`, dashes, and a hash if it can be a name), so the
+    // resolvers below neither rescan nor hash the long operands that can never match
+    argxcClassifyTokens(argv, result->argc, spec->longestName, result->tokens);
+
+    // Single pass over argv: resolve every token to the name key it matches
+    for (size_t k = 1; k < result->argc; k++)
+	{
+        const char *arg = argv[k];
+        if (!arg) continue;
+
+        ARGX_STATS_ADD(tokensScanned, 1);
+
+        const ArgxcTokenInfo *info = &result->tokens[k];
+        const char *value = NULL;
+        int matches = 0;
+
+        // Everything after `--` is an operand, neither an option nor a command
+        if (info->kind == ARGX_TOKEN_END_OF_OPTIONS && endOfOptions >= 0 && (int)k >= endOfOptions)
+		{
+            result->endOfOptions = (int)k;
+            break;
+        }
+
+        size_t command = ARGX_INDEX_END;
+
+        // Words walk the command tree: one probe against the children of the last command
+        if (info->kind == ARGX_TOKEN_WORD && info->hashed)
+		{
+            uint32_t parent = result->depth > 0 ? result->path[result->depth - 1] : ARGX_SPEC_NONE;
+            command = findChildName(spec, parent, arg, info->length, info->hash);
+
+            if (command != ARGX_INDEX_END)
+			{
+                result->path[result->depth] = (uint32_t)command;
+                result->pathPos[result->depth++] = (int)k;
+            }
+        }
+
+        size_t key = resolveToken(spec, arg, info, abbrev, &value, &matches);
+
+        if (key == ARGX_INDEX_END)
+		{
+            if (matches > 1)
+			{
+                result->ambiguousCount++;
+                continue;
+            }
+
+            size_t count = matchCluster(spec, arg, info);
+            if (count == 0) continue;
+
+            for (size_t i = 1; i <= count && !stopped; i++)
+			{
+                size_t shortKey = spec->shortKeys[(unsigned char)arg[i]];
+
+                markKey(result, shortKey, k);
+
+                // Only booleans can precede the end of a cluster
+                if (i == count) continue;
+
+                storeValue(result, shortKey, NULL, k);
+                if (actions) stopped = !dispatchToken(result, actions, ARGX_INDEX_END, shortKey, NULL, 0, 0, NULL, k, &scope);
+            }
+
+            // The last option of the cluster gets the rest of the token, if any
+            key = spec->shortKeys[(unsigned char)arg[count]];
+            if (arg[count + 1] != '\0') value = arg + count + 1;
+        }
+        else markKey(result, key, k);
+
+        size_t last = storeValue(result, key, value, k);
+
+        if (actions && !stopped)
+		{
+            stopped = !dispatchToken(result, actions, command, key, value || !info->hashed ? NULL : arg,
+                    info->length, info->hash, value, k, &scope);
+        }
+
+        if (stopped)
+		{
+            result->stopPos = (int)k;
+            break;
+        }
+
+        k = last;
+    }
+
+    fillWide(result);
+
+    ARGX_TRACE_END(ARGX_TRACE_SPEC_PARSE);
+}
+
+ArgxcResult *argxcSpecParseLine(ArgxcArena *arena, const ArgxcSpec *spec, int argc, char *const argv[],
+        const ArgxcActionBinding *actions, int endOfOptions)
+{
+    if (!spec || (argc > 0 && !argv)) return NULL;
+
+    size_t depthCapacity = argc > 0 ? (size_t)argc : 0; // Each command consumes a token
+    char *block = argxcArenaAlloc(arena, layoutResult(spec, depthCapacity, NULL));
+    if (!block) return NULL;
+
+    ArgxcResult *result = (ArgxcResult *)block;
+
+    layoutResult(spec, depthCapacity, block);
+    result->spec = spec;
+    result->arena = arena;
+
+    scanLine(result, argc, argv, actions, endOfOptions);
+
+    return result;
+}
+
+ArgxcResult *argxcResultReparseLine(ArgxcResult *result, int argc, char *const argv[], const ArgxcActionBinding *actions,
+        int endOfOptions)
+{
+    if (!result || (argc > 0 && !argv)) return NULL;
+
+    size_t depthCapacity = argc > 0 ? (size_t)argc : 0;
+
+    // Only a longer line than any before needs room for more command words
+    if (depthCapacity > result->depthCapacity)
+	{
+        const ArgxcSpec *spec = result->spec;
+        char *block = argxcArenaRealloc(result->arena, result, layoutResult(spec, result->depthCapacity, NULL),
+                layoutResult(spec, depthCapacity, NULL));
+        if (!block) return NULL;
+
+        result = (ArgxcResult *)block;
+        layoutResult(spec, depthCapacity, block);
+    }
+
+    scanLine(result, argc, argv, actions, endOfOptions);
+
+    return result;
+}
+
+ArgxcResult *argxcResultReparse(ArgxcResult *result, int argc, char *const argv[], const ArgxcActionBinding *actions)
+{
+    return argxcResultReparseLine(result, argc, argv, actions, 0);
+}
+
+ArgxcResult *argxcSpecParseIn(ArgxcArena *arena, const ArgxcSpec *spec, int argc, char *const argv[])
+{
+    return argxcSpecParseLine(arena, spec, argc, argv, NULL, 0);
+}
+
+ArgxcResult *argxcSpecParse(const ArgxcSpec *spec, int argc, char *const argv[])
+{
+    return argxcSpecParseIn(NULL, spec, argc, argv);
+}
+
+ArgxcResult *argxcSpecDispatchIn(ArgxcArena *arena, const ArgxcSpec *spec, int argc, char *const argv[],
+        const ArgxcActionBinding *actions)
+{
+    if (!actions) return NULL;
+
+    return argxcSpecParseLine(arena, spec, argc, argv, actions, 0);
+}
+
+ArgxcResult *argxcSpecDispatch(const ArgxcSpec *spec, int argc, char *const argv[], const ArgxcActionBinding *actions)
+{
+    return argxcSpecDispatchIn(NULL, spec, argc, argv, actions);
+}
+
+int argxcResultGetStopPos(const ArgxcResult *result)
+{
+    return result ? result->stopPos : -1;
+}
+
+int argxcResultGetEndOfOptions(const ArgxcResult *result)
+{
+    return result ? result->endOfOptions : -1;
+}
+
+void argxcResultDestroy(ArgxcResult *result)
+{
+    if (!result) return;
+
+    argxcArenaFree(result->arena, result);
+}
+
+const ArgxcSpec *argxcResultGetSpec(const ArgxcResult *result)
+{
+    return result ? result->spec : NULL;
+}
+
+size_t argxcResultGetAmbiguousCount(const ArgxcResult *result)
+{
+    return result ? result->ambiguousCount : 0;
+}
+
+int argxcResultFindAmbiguous(const ArgxcResult *result, int from)
+{
+    if (!result || result->ambiguousCount == 0) return -1;
+
+    // Rare error path: recheck the tokens instead of storing them during the parse
+    for (size_t k = from > 1 ? (size_t)from : 1; k < result->argc; k++)
+	{
+        if (result->argv[k] && argxcSpecResolveAbbrev(result->spec, result->argv[k], NULL) > 1) return (int)k;
+    }
+
+    return -1;
+}
+
+size_t argxcResultGetCommandDepth(const ArgxcResult *result)
+{
+    return result ? result->depth : 0;
+}
+
+size_t argxcResultGetCommandAt(const ArgxcResult *result, size_t depth)
+{
+    return result && depth < result->depth ? result->path[depth] : (size_t)-1;
+}
+
+int argxcResultGetCommandPos(const ArgxcResult *result, size_t depth)
+{
+    return result && depth < result->depth ? result->pathPos[depth] : -1;
+}
+
+const char *argxcResultGetCommandId(const ArgxcResult *result, size_t depth)
+{
+    if (!result || depth >= result->depth) return NULL;
+
+    uint32_t id = result->spec->texts[result->path[depth]].id;
+
+    return id != ARGX_SPEC_NONE ? result->spec->strings + id : NULL;
+}
+
+// Argv position of a node on the command path, -1 if it is not a command of this line
+static int commandPos(const ArgxcResult *result, size_t index)
+{
+    for (size_t d = 0; d < result->depth; d++)
+	{
+        if (result->path[d] == index) return result->pathPos[d];
+    }
+
+    return -1;
+}
+
+// First argv position of a node (either of its names), -1 if absent
+static int nodeFirstPos(const ArgxcResult *result, size_t index)
+{
+    const ArgxcSpecNode *node = &result->spec->nodes[index];
+    int pos = -1;
+
+    for (int k = 0; k < 2; k++)
+	{
+        if (node->nameKeys[k] == ARGX_SPEC_NONE) continue;
+
+        int keyPos = result->keyFirstPos[node->nameKeys[k]];
+        if (keyPos >= 0 && (pos < 0 || keyPos < pos)) pos = keyPos;
+    }
+
+    return pos;
+}
+
+// Last argv position of a node (either of its names), -1 if absent
+static int nodeLastPos(const ArgxcResult *result, size_t index)
+{
+    const ArgxcSpecNode *node = &result->spec->nodes[index];
+    int pos = -1;
+
+    for (int k = 0; k < 2; k++)
+	{
+        if (node->nameKeys[k] == ARGX_SPEC_NONE) continue;
+
+        int keyPos = result->keyLastPos[node->nameKeys[k]];
+        if (keyPos > pos) pos = keyPos;
+    }
+
+    return pos;
+}
+
+// Presence bits of the sub-parameters of a node, `(childCount + 63) / 64` words at `bits`
+static void subParamBits(const ArgxcResult *result, size_t index, uint64_t *bits)
+{
+    const ArgxcSpecNode *node = &result->spec->nodes[index];
+    int ownPos = commandPos(result, index);
+    int after = ownPos >= 0 ? ownPos : node->parent < 0 ? nodeFirstPos(result, index) : -1;
+
+    memset(bits, 0, (node->childCount + 63) / 64 * sizeof(uint64_t));
+
+    for (size_t j = 0; j < node->childCount; j++)
+	{
+        if (nodeLastPos(result, node->firstChild + j) > after) bits[j / 64] |= (uint64_t)1 << (j % 64);
+    }
+
+    // `--opt=choice` names its sub-option inside the same token
+    if (node->valueType == ARGX_VALUE_ENUM && result->values[node->valueSlot].status == ARGX_VALUE_OK)
+	{
+        size_t j = result->values[node->valueSlot].as.e;
+
+        bits[j / 64] |= (uint64_t)1 << (j % 64);
+    }
+}
+
+// Presence words of the options with more than 64 sub-parameters, filled once per scan so
+// that getters only read the result
+static void fillWide(ArgxcResult *result)
+{
+    const ArgxcSpec *spec = result->spec;
+    if (spec->wideWords == 0) return;
+
+    for (size_t i = 0; i < spec->nodesCount; i++)
+	{
+        const ArgxcSpecNode *node = &spec->nodes[i];
+
+        if (node->childCount > 64) subParamBits(result, i, &result->wide[node->wideOffset]);
+    }
+}
+
+// Position of the child `id` among the children of `parent` (the first one when several
+// share the id), ARGX_INDEX_END if none
+static size_t findChild(const ArgxcSpec *spec, size_t parent, const char *id)
+{
+    size_t len = 0;
+    uint32_t hash = childHash(argxcIndexHash(id, &len), parent);
+    size_t child = ARGX_INDEX_END;
+
+    for (size_t pos = specFind(spec, ARGX_INDEX_CHILD, id, len, hash);
+            pos != ARGX_INDEX_END; pos = specNext(spec, pos, ARGX_INDEX_CHILD, id, len, hash))
+	{
+        size_t index = spec->entries[pos].slot;
+
+        if ((size_t)spec->nodes[index].parent != parent) continue;
+        if (index - spec->nodes[parent].firstChild < child) child = index - spec->nodes[parent].firstChild;
+    }
+
+    return child;
+}
+
+// Node with the given id on the command path, or among the children of a command, deepest
+// first: O(depth) lookups whatever the size of the tree, ARGX_INDEX_END if none
+static size_t findPathNode(const ArgxcResult *result, const char *id)
+{
+    const ArgxcSpec *spec = result->spec;
+
+    for (size_t d = result->depth; d-- > 0;)
+	{
+        const ArgxcSpecNode *command = &spec->nodes[result->path[d]];
+        uint32_t commandId = spec->texts[result->path[d]].id;
+
+        if (commandId != ARGX_SPEC_NONE && strcmp(spec->strings + commandId, id) == 0) return result->path[d];
+
+        size_t child = findChild(spec, result->path[d], id);
+        if (child != ARGX_INDEX_END) return command->firstChild + child;
+    }
+
+    return ARGX_INDEX_END;
+}
+
+// Lowest node with the given id whose presence rules match; nodes are numbered breadth-first,
+// so this is the first top-level option, or the first sub-option of the first present parent
+static size_t findIdNode(const ArgxcResult *result, const char *id, bool topLevel, bool requireSubParams)
+{
+    const ArgxcSpec *spec = result->spec;
+    size_t len = 0;
+    uint32_t hash = argxcIndexHash(id, &len);
+    size_t pos = specFind(spec, ARGX_INDEX_ID, id, len, hash);
+
+    if (pos == ARGX_INDEX_END) return ARGX_INDEX_END;
+
+    for (size_t index = spec->entries[pos].slot; index != ARGX_SPEC_NONE; index = spec->texts[index].nextSameId)
+	{
+        const ArgxcSpecNode *node = &spec->nodes[index];
+
+        if (topLevel)
+		{
+            // Top-level nodes come first in the chain
+            if (node->parent >= 0) break;
+            if (nodeFirstPos(result, index) >= 0) return index;
+        }
+        else
+		{
+            if (node->parent < 0 || nodeFirstPos(result, node->parent) < 0) continue;
+
+            const ArgxcSpecNode *parent = &spec->nodes[node->parent];
+            if (requireSubParams && !(parent->hasSubParams || parent->hasAnySubParams)) continue;
+
+            return index;
+        }
+    }
+
+    return ARGX_INDEX_END;
+}
+
+static ArgxcParam paramAt(const ArgxcResult *result, size_t index);
+
+// Index of a node among its siblings (top-level nodes come first, so theirs is their own)
+static int siblingIndex(const ArgxcSpec *spec, size_t index)
+{
+    const ArgxcSpecNode *node = &spec->nodes[index];
+
+    return node->parent < 0 ? (int)index : (int)(index - spec->nodes[node->parent].firstChild);
+}
+
+int argxcResultFindParam(const ArgxcResult *result, const char *id)
+{
+    if (!result || !id) return -1;
+
+    const ArgxcSpec *spec = result->spec;
+
+    // Commands of any depth, and the options under them, like argxcResultGetParam()
+    size_t index = findPathNode(result, id);
+    if (index != ARGX_INDEX_END && paramAt(result, index).exists) return siblingIndex(spec, index);
+
+    // Then check if it's a main parameter that exists in arguments
+    index = findIdNode(result, id, true, false);
+    if (index != ARGX_INDEX_END) return (int)index;
+
+    // Then look for sub-parameters whose parent exists in arguments
+    index = findIdNode(result, id, false, false);
+    if (index != ARGX_INDEX_END) return siblingIndex(spec, index);
+
+    return -1; // Not found
+}
+
+bool argxcResultParamExists(const ArgxcResult *result, const char *id)
+{
+    return argxcResultFindParam(result, id) >= 0;
+}
+
+// Presence of a node and of its sub-parameters. Commands and the sub-parameters of a main
+// option or of a command count when they appear after it; deeper ones count anywhere once
+// their parent is present. Reads the result only: wide words were filled by fillWide().
+static ArgxcParam paramAt(const ArgxcResult *result, size_t index)
+{
+    ArgxcParam param = {false, 0, 0, NULL, index};
+    const ArgxcSpec *spec = result->spec;
+    const ArgxcSpecNode *node = &spec->nodes[index];
+    bool topLevel = node->parent < 0;
+    int ownPos = commandPos(result, index);
+
+    // A sub-parameter must appear after its parent
+    if (ownPos >= 0) param.exists = true;
+    else if (topLevel) param.exists = nodeFirstPos(result, index) >= 0;
+    else
+	{
+        int parentPos = commandPos(result, (size_t)node->parent);
+        if (parentPos < 0) parentPos = nodeFirstPos(result, node->parent);
+
+        param.exists = parentPos >= 0 && nodeLastPos(result, index) > parentPos;
+    }
+
+    if (!param.exists || !(node->hasSubParams || node->hasAnySubParams)) return param;
+
+    param.subExistsCount = node->childCount;
+
+    if (node->childCount > 64)
+	{
+        param.subExistsWide = &result->wide[node->wideOffset];
+        param.subExistsBits = param.subExistsWide[0];
+    }
+    else subParamBits(result, index, &param.subExistsBits);
+
+    return param;
+}
+
+ArgxcParam argxcResultGetParam(const ArgxcResult *result, const char *id)
+{
+    ArgxcParam param = {false, 0, 0, NULL, ARGX_INDEX_END};
+
+    if (!result || !id || result->argc <= 1) return param;
+
+    // The command path scopes ids: `list` under the given command wins over other `list`s
+    size_t index = findPathNode(result, id);
+
+    // Then check if this is a top-level option
+    if (index == ARGX_INDEX_END) index = findIdNode(result, id, true, false);
+
+    // If not found as top-level, check if it's a sub-parameter
+    if (index == ARGX_INDEX_END) index = findIdNode(result, id, false, true);
+    if (index == ARGX_INDEX_END) return param;
+
+    return paramAt(result, index);
+}
+
+ArgxcParam argxcResultGetParamAt(const ArgxcResult *result, size_t handle)
+{
+    ArgxcParam param = {false, 0, 0, NULL, ARGX_INDEX_END};
+
+    if (!result || handle >= result->spec->nodesCount) return param;
+
+    return paramAt(result, handle);
+}
+
+bool argxcResultGetSubParam(const ArgxcResult *result, const ArgxcParam *param, const char *id)
+{
+    if (!result || !param || !id || !param->exists || param->node >= result->spec->nodesCount) return false;
+
+    size_t child = findChild(result->spec, param->node, id);
+
+    return child != ARGX_INDEX_END && argxcParamHasSubAt(param, child);
+}
+
+bool argxcResultGetSubParamAt(const ArgxcResult *result, const ArgxcParam *param, size_t handle)
+{
+    if (!result || !param || !param->exists || param->node >= result->spec->nodesCount) return false;
+    if (handle >= result->spec->nodesCount || result->spec->nodes[handle].parent != (int32_t)param->node) return false;
+
+    return argxcParamHasSubAt(param, handle - result->spec->nodes[param->node].firstChild);
+}
+
+// Slot of a node, after checking its declared type
+static ArgxcValueStatus slotAt(const ArgxcResult *result, size_t index, ArgxcValueType type, const ArgxcValueSlot **slot)
+{
+    const ArgxcSpecNode *node = &result->spec->nodes[index];
+    if (node->valueType != type) return ARGX_VALUE_MISMATCH;
+
+    *slot = &result->values[node->valueSlot];
+
+    return (*slot)->status;
+}
+
+// Slot of the option `id` (resolved like argxcResultFindParam(), falling back to the first
+// option with that id when none is present), after checking its declared type
+static ArgxcValueStatus findValue(const ArgxcResult *result, const char *id, ArgxcValueType type, const ArgxcValueSlot **slot)
+{
+    if (!result || !id) return ARGX_VALUE_UNSET;
+
+    const ArgxcSpec *spec = result->spec;
+    size_t index = findIdNode(result, id, true, false);
+
+    if (index == ARGX_INDEX_END) index = findIdNode(result, id, false, false);
+
+    if (index == ARGX_INDEX_END)
+	{
+        size_t len = 0;
+        uint32_t hash = argxcIndexHash(id, &len);
+        size_t pos = specFind(spec, ARGX_INDEX_ID, id, len, hash);
+
+        if (pos == ARGX_INDEX_END) return ARGX_VALUE_UNSET;
+
+        index = spec->entries[pos].slot;
+    }
+
+    return slotAt(result, index, type, slot);
+}
+
+static ArgxcValueStatus findValueAt(const ArgxcResult *result, size_t handle, ArgxcValueType type, const ArgxcValueSlot **slot)
+{
+    if (!result || handle >= result->spec->nodesCount) return ARGX_VALUE_UNSET;
+
+    return slotAt(result, handle, type, slot);
+}
+
+ArgxcValueStatus argxcResultGetInt64(const ArgxcResult *result, const char *id, int64_t *value)
+{
+    const ArgxcValueSlot *slot = NULL;
+    ArgxcValueStatus status = findValue(result, id, ARGX_VALUE_INT64, &slot);
+
+    if (status == ARGX_VALUE_OK && value) *value = slot->as.i;
+
+    return status;
+}
+
+ArgxcValueStatus argxcResultGetUint64(const ArgxcResult *result, const char *id, uint64_t *value)
+{
+    const ArgxcValueSlot *slot = NULL;
+    ArgxcValueStatus status = findValue(result, id, ARGX_VALUE_UINT64, &slot);
+
+    if (status == ARGX_VALUE_OK && value) *value = slot->as.u;
+
+    return status;
+}
+
+ArgxcValueStatus argxcResultGetDouble(const ArgxcResult *result, const char *id, double *value)
+{
+    const ArgxcValueSlot *slot = NULL;
+    ArgxcValueStatus status = findValue(result, id, ARGX_VALUE_DOUBLE, &slot);
+
+    if (status == ARGX_VALUE_OK && value) *value = slot->as.d;
+
+    return status;
+}
+
+ArgxcValueStatus argxcResultGetBool(const ArgxcResult *result, const char *id, bool *value)
+{
+    const ArgxcValueSlot *slot = NULL;
+    ArgxcValueStatus status = findValue(result, id, ARGX_VALUE_BOOL, &slot);
+
+    if (status == ARGX_VALUE_OK && value) *value = slot->as.b;
+
+    return status;
+}
+
+ArgxcValueStatus argxcResultGetString(const ArgxcResult *result, const char *id, const char **value)
+{
+    const ArgxcValueSlot *slot = NULL;
+    ArgxcValueStatus status = findValue(result, id, ARGX_VALUE_STRING, &slot);
+
+    if (status == ARGX_VALUE_OK && value) *value = slot->as.s;
+
+    return status;
+}
+
+ArgxcValueStatus argxcResultGetEnum(const ArgxcResult *result, const char *id, size_t *value)
+{
+    const ArgxcValueSlot *slot = NULL;
+    ArgxcValueStatus status = findValue(result, id, ARGX_VALUE_ENUM, &slot);
+
+    if (status == ARGX_VALUE_OK && value) *value = slot->as.e;
+
+    return status;
+}
+
+ArgxcValueStatus argxcResultGetInt64At(const ArgxcResult *result, size_t handle, int64_t *value)
+{
+    const ArgxcValueSlot *slot = NULL;
+    ArgxcValueStatus status = findValueAt(result, handle, ARGX_VALUE_INT64, &slot);
+
+    if (status == ARGX_VALUE_OK && value) *value = slot->as.i;
+
+    return status;
+}
+
+ArgxcValueStatus argxcResultGetUint64At(const ArgxcResult *result, size_t handle, uint64_t *value)
+{
+    const ArgxcValueSlot *slot = NULL;
+    ArgxcValueStatus status = findValueAt(result, handle, ARGX_VALUE_UINT64, &slot);
+
+    if (status == ARGX_VALUE_OK && value) *value = slot->as.u;
+
+    return status;
+}
+
+ArgxcValueStatus argxcResultGetDoubleAt(const ArgxcResult *result, size_t handle, double *value)
+{
+    const ArgxcValueSlot *slot = NULL;
+    ArgxcValueStatus status = findValueAt(result, handle, ARGX_VALUE_DOUBLE, &slot);
+
+    if (status == ARGX_VALUE_OK && value) *value = slot->as.d;
+
+    return status;
+}
+
+ArgxcValueStatus argxcResultGetBoolAt(const ArgxcResult *result, size_t handle, bool *value)
+{
+    const ArgxcValueSlot *slot = NULL;
+    ArgxcValueStatus status = findValueAt(result, handle, ARGX_VALUE_BOOL, &slot);
+
+    if (status == ARGX_VALUE_OK && value) *value = slot->as.b;
+
+    return status;
+}
+
+ArgxcValueStatus argxcResultGetStringAt(const ArgxcResult *result, size_t handle, const char **value)
+{
+    const ArgxcValueSlot *slot = NULL;
+    ArgxcValueStatus status = findValueAt(result, handle, ARGX_VALUE_STRING, &slot);
+
+    if (status == ARGX_VALUE_OK && value) *value = slot->as.s;
+
+    return status;
+}
+
+ArgxcValueStatus argxcResultGetEnumAt(const ArgxcResult *result, size_t handle, size_t *value)
+{
+    const ArgxcValueSlot *slot = NULL;
+    ArgxcValueStatus status = findValueAt(result, handle, ARGX_VALUE_ENUM, &slot);
+
+    if (status == ARGX_VALUE_OK && value) *value = slot->as.e;
+
+    return status;
+}
@@ -0,0 +1,153 @@
+/* src/ARGXStats.c
+ * Owned and created by: pcannon09
+ */
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#	define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdlib.h>
+
+#include "ARGXAtomic.h"
+#include "ARGXStats.h"
+
+#if ARGX_STATS || ARGX_TRACE
+
+#ifdef _WIN32
+#	include <windows.h>
+#else
+#	include <time.h>
+#endif
+
+uint64_t argxcStatsNow(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER counter, frequency;
+
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+
+    return (uint64_t)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+#endif
+
+#if ARGX_STATS
+
+ARGX_THREAD_LOCAL ArgxcStats *argxcStatsSink = NULL;
+
+// Default counters of each thread, named by serial so that an instance destroyed on any thread
+// can withdraw its own: one entry per thread that created an instance still alive
+typedef struct {
+    uint64_t serial;
+    ArgxcStats *stats;
+} ArgxcStatsDefault;
+
+static ARGX_THREAD_LOCAL uint64_t defaultSerial = 0;
+static ArgxcStatsDefault *defaults = NULL;
+static size_t defaultsCount = 0;
+static size_t defaultsCapacity = 0;
+static uint64_t defaultsNext = 0;
+static uint64_t defaultsLock = 0;
+
+// Position of `serial` among `defaults`, defaultsCount if absent (the lock must be held)
+static size_t findDefault(uint64_t serial)
+{
+    size_t i = 0;
+    while (i < defaultsCount && defaults[i].serial != serial) i++;
+    return i;
+}
+
+static void removeDefault(uint64_t serial)
+{
+    size_t i = findDefault(serial);
+    if (i < defaultsCount) defaults[i] = defaults[--defaultsCount];
+
+    if (defaultsCount == 0)
+	{
+        free(defaults); defaults = NULL;
+        defaultsCapacity = 0;
+    }
+}
+
+uint64_t argxcStatsSetDefault(ArgxcStats *stats)
+{
+    while (!ARGX_ATOMIC_CAS(&defaultsLock, 0, 1)) {}
+
+    // The previous default of this thread is no longer the latest instance created here
+    removeDefault(defaultSerial);
+    defaultSerial = 0;
+
+    if (defaultsCount == defaultsCapacity)
+	{
+        size_t capacity = defaultsCapacity ? defaultsCapacity * 2 : 4;
+        ArgxcStatsDefault *grown = realloc(defaults, capacity * sizeof(*grown));
+
+        if (grown)
+		{
+            defaults = grown;
+            defaultsCapacity = capacity;
+        }
+    }
+
+    if (defaultsCount < defaultsCapacity)
+	{
+        defaultSerial = ++defaultsNext;
+        defaults[defaultsCount].serial = defaultSerial;
+        defaults[defaultsCount].stats = stats;
+        defaultsCount++;
+    }
+
+    uint64_t serial = defaultSerial;
+
+    ARGX_ATOMIC_STORE_RELEASE(&defaultsLock, 0);
+
+    return serial;
+}
+
+void argxcStatsDropDefault(uint64_t serial)
+{
+    if (serial == 0) return;
+
+    while (!ARGX_ATOMIC_CAS(&defaultsLock, 0, 1)) {}
+    removeDefault(serial);
+    ARGX_ATOMIC_STORE_RELEASE(&defaultsLock, 0);
+}
+
+void argxcStatsMergeDefault(const ArgxcStats *counted)
+{
+    if (defaultSerial == 0) return;
+
+    while (!ARGX_ATOMIC_CAS(&defaultsLock, 0, 1)) {}
+
+    size_t i = findDefault(defaultSerial);
+    if (i < defaultsCount) argxcStatsMerge(defaults[i].stats, counted);
+
+    ARGX_ATOMIC_STORE_RELEASE(&defaultsLock, 0);
+}
+
+void argxcStatsMerge(ArgxcStats *into, const ArgxcStats *from)
+{
+    into->tokensScanned += from->tokensScanned;
+    into->stringCompares += from->stringCompares;
+    into->hashProbes += from->hashProbes;
+    into->allocations += from->allocations;
+    into->allocatedBytes += from->allocatedBytes;
+    into->createNs += from->createNs;
+    into->parseNs += from->parseNs;
+    into->lookupNs += from->lookupNs;
+    into->docsNs += from->docsNs;
+}
+
+#endif
+
+#if !ARGX_STATS && !ARGX_TRACE
+// ISO C forbids an empty translation unit
+typedef int ArgxcStatsDisabled;
+#endif
@@ -0,0 +1,123 @@
+/* src/ARGXStats.h
+ * Owned and created by: pcannon09
+ * Internal counters behind argxcGetStats() and trace points behind argxcTraceStart();
+ * each is compiled out unless ARGX_STATS / ARGX_TRACE is set
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "../inc/types.h"
+#include "../inc/macros.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if ARGX_STATS || ARGX_TRACE
+#	if defined(_MSC_VER)
+#		define ARGX_THREAD_LOCAL __declspec(thread)
+#	else
+#		define ARGX_THREAD_LOCAL __thread
+#	endif
+
+	/**
+ 	 * @brief Read the monotonic clock (CLOCK_MONOTONIC, or QueryPerformanceCounter on Windows).
+ 	 *
+ 	 * @return uint64_t Nanoseconds from an arbitrary origin.
+ 	 */
+	uint64_t argxcStatsNow(void);
+#endif
+
+#if ARGX_STATS
+	// Counters of the instrumented call running on this thread, NULL outside of one
+	extern ARGX_THREAD_LOCAL ArgxcStats *argxcStatsSink;
+
+	/**
+ 	 * @brief Make `stats` the counters of the calls without an instance (argxcCompareArgs()) on this thread.
+ 	 *
+ 	 * @return uint64_t Serial to hand to argxcStatsDropDefault(), 0 if it could not be recorded.
+ 	 */
+	uint64_t argxcStatsSetDefault(ArgxcStats *stats);
+
+	/**
+ 	 * @brief Withdraw the counters set under `serial`; safe from any thread, 0 does nothing.
+ 	 */
+	void argxcStatsDropDefault(uint64_t serial);
+
+	/**
+ 	 * @brief Add `counted` to this thread's default counters, if their instance still exists.
+ 	 */
+	void argxcStatsMergeDefault(const ArgxcStats *counted);
+
+	/**
+ 	 * @brief Add every counter of `from` to `into`.
+ 	 */
+	void argxcStatsMerge(ArgxcStats *into, const ArgxcStats *from);
+
+	/**
+ 	 * @brief Get the counters of an instance (defined in Argx.c, which owns the struct).
+ 	 */
+	ArgxcStats *argxcStatsOf(Argxc *argxc);
+
+#	define ARGX_STATS_ADD(field, n) do { if (argxcStatsSink) argxcStatsSink->field += (n); } while (0)
+#	define ARGX_STATS_ALLOC(bytes) do { ARGX_STATS_ADD(allocations, 1); ARGX_STATS_ADD(allocatedBytes, bytes); } while (0)
+
+	// Time a call and route its counters to `stats` (NULL counts nothing) until ARGX_STATS_END()
+#	define ARGX_STATS_BEGIN(stats) \
+    	ArgxcStats *argxcStatsOuter = argxcStatsSink; \
+    	uint64_t argxcStatsStart = argxcStatsNow(); \
+    	argxcStatsSink = (stats)
+
+#	define ARGX_STATS_END(field) \
+    	do { \
+        	if (argxcStatsSink) argxcStatsSink->field += argxcStatsNow() - argxcStatsStart; \
+        	argxcStatsSink = argxcStatsOuter; \
+    	} while (0)
+#else
+#	define ARGX_STATS_ADD(field, n) ((void)0)
+#	define ARGX_STATS_ALLOC(bytes) ((void)0)
+#	define ARGX_STATS_BEGIN(stats) ((void)0)
+#	define ARGX_STATS_END(field) ((void)0)
+#endif
+
+	// Phases recorded by the tracer (names in ARGXTrace.c)
+	typedef enum {
+    	ARGX_TRACE_CREATE,
+    	ARGX_TRACE_RESPONSE_FILES,
+    	ARGX_TRACE_TOKENIZE,
+    	ARGX_TRACE_ADD_OPTION,
+    	ARGX_TRACE_ADD_SUB_OPTION,
+    	ARGX_TRACE_PARSE,
+    	ARGX_TRACE_SPEC_CREATE,
+    	ARGX_TRACE_SPEC_PARSE,
+    	ARGX_TRACE_CLASSIFY,
+    	ARGX_TRACE_FIND_PARAM,
+    	ARGX_TRACE_GET_PARAM,
+    	ARGX_TRACE_GET_SUB_PARAM,
+    	ARGX_TRACE_COMPARE_ARGS,
+    	ARGX_TRACE_DIAGNOSE_BATCH,
+    	ARGX_TRACE_DOCS,
+
+    	ARGX_TRACE_EVENT_COUNT
+	} ArgxcTraceEvent;
+
+#if ARGX_TRACE
+	/**
+ 	 * @brief Record a begin ('B') or end ('E') event; does nothing while tracing is stopped.
+ 	 *
+ 	 * Never allocates or locks: the slot is reserved with one atomic increment.
+ 	 */
+	void argxcTraceRecord(ArgxcTraceEvent event, char phase);
+
+#	define ARGX_TRACE_BEGIN(event) argxcTraceRecord(event, 'B')
+#	define ARGX_TRACE_END(event) argxcTraceRecord(event, 'E')
+#else
+#	define ARGX_TRACE_BEGIN(event) ((void)0)
+#	define ARGX_TRACE_END(event) ((void)0)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
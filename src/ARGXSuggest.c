@@ -0,0 +1,166 @@
+/* src/ARGXSuggest.c
+ * Owned and created by: pcannon09
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "ARGXSuggest.h"
+#include "ARGXStats.h"
+
+// Distance allowed for a token: about one edit per three characters of the name after its
+// dashes, and two from four characters on, so that a swap of two letters (`--vrebose`) is found
+static size_t distanceBound(const char *token, size_t len)
+{
+    size_t dashes = 0;
+    while (dashes < len && dashes < 2 && token[dashes] == '-') dashes++;
+
+    size_t core = len - dashes;
+
+    return core < 4 ? 1 : core < 6 ? 2 : core / 3;
+}
+
+bool argxcSuggestInit(ArgxcSuggest *suggest, const char *token, size_t max)
+{
+    size_t len = token ? strlen(token) : 0;
+    size_t blocks = (len + 63) / 64;
+
+    memset(suggest, 0, offsetof(ArgxcSuggest, inlineWords));
+    suggest->len = len;
+    suggest->blocks = blocks;
+    suggest->maxDistance = distanceBound(token, len);
+    suggest->max = max < ARGX_SUGGEST_MAX ? max : ARGX_SUGGEST_MAX;
+
+    uint64_t *words = suggest->inlineWords;
+
+    if (blocks > 1)
+	{
+        if (blocks > SIZE_MAX / sizeof(uint64_t) / 258) return false;
+
+        words = malloc(258 * blocks * sizeof(uint64_t));
+        if (!words) return false;
+
+        ARGX_STATS_ALLOC(258 * blocks * sizeof(uint64_t));
+    }
+
+    suggest->peq = words;
+    suggest->pv = words + 256 * blocks;
+    suggest->mv = suggest->pv + blocks;
+
+    memset(suggest->peq, 0, 256 * blocks * sizeof(uint64_t));
+
+    for (size_t i = 0; i < len; i++)
+        suggest->peq[(unsigned char)token[i] * blocks + i / 64] |= (uint64_t)1 << (i % 64);
+
+    return true;
+}
+
+// Edit distance between the token and `name`, or a value above `bound` once it cannot be
+// within it. Columns advance one name character at a time; each 64-bit block holds the
+// vertical deltas of 64 token characters, and the horizontal delta of its last row is
+// carried into the next block (Myers 1999, with Hyyro's formulation of the block step).
+static size_t distanceTo(ArgxcSuggest *suggest, const char *name, size_t n, size_t bound)
+{
+    size_t blocks = suggest->blocks;
+    size_t last = blocks - 1;
+    uint64_t lastBit = (uint64_t)1 << ((suggest->len - 1) % 64);
+    uint64_t *pv = suggest->pv;
+    uint64_t *mv = suggest->mv;
+    size_t score = suggest->len;
+
+    for (size_t b = 0; b < blocks; b++)
+	{
+        pv[b] = ~(uint64_t)0;
+        mv[b] = 0;
+    }
+
+    for (size_t j = 0; j < n; j++)
+	{
+        const uint64_t *peq = suggest->peq + (unsigned char)name[j] * blocks;
+        int carry = 1; // Row 0 of an edit distance grows by one per column
+
+        for (size_t b = 0; b < blocks; b++)
+		{
+            uint64_t eq = peq[b];
+            uint64_t xv = eq | mv[b];
+
+            if (carry < 0) eq |= 1;
+
+            uint64_t xh = (((eq & pv[b]) + pv[b]) ^ pv[b]) | eq;
+            uint64_t ph = mv[b] | ~(xh | pv[b]);
+            uint64_t mh = pv[b] & xh;
+            uint64_t high = b == last ? lastBit : (uint64_t)1 << 63;
+            int out = (ph & high) ? 1 : (mh & high) ? -1 : 0;
+
+            ph <<= 1;
+            mh <<= 1;
+
+            if (carry < 0) mh |= 1;
+            else if (carry > 0) ph |= 1;
+
+            pv[b] = mh | ~(xv | ph);
+            mv[b] = ph & xv;
+            carry = out;
+        }
+
+        score += carry;
+
+        // Each remaining character lowers the distance by one at most
+        if (score > bound + (n - j - 1)) return bound + 1;
+    }
+
+    return score;
+}
+
+void argxcSuggestOffer(ArgxcSuggest *suggest, const char *name)
+{
+    if (!name || suggest->max == 0) return;
+
+    size_t bound = suggest->maxDistance;
+
+    // Once full, only a closer name can replace the last kept one
+    if (suggest->count == suggest->max)
+	{
+        size_t worst = suggest->distances[suggest->count - 1];
+
+        if (worst == 0) return;
+        if (worst - 1 < bound) bound = worst - 1;
+    }
+
+    size_t n = strlen(name);
+    size_t gap = n > suggest->len ? n - suggest->len : suggest->len - n;
+
+    if (gap > bound) return;
+
+    size_t distance = suggest->blocks ? distanceTo(suggest, name, n, bound) : n;
+    if (distance > bound) return;
+
+    for (size_t i = 0; i < suggest->count; i++)
+	{
+        if (strcmp(suggest->names[i], name) == 0) return;
+    }
+
+    size_t at = suggest->count < suggest->max ? suggest->count++ : suggest->count - 1;
+
+    for (; at > 0 && suggest->distances[at - 1] > distance; at--)
+	{
+        suggest->names[at] = suggest->names[at - 1];
+        suggest->distances[at] = suggest->distances[at - 1];
+    }
+
+    suggest->names[at] = name;
+    suggest->distances[at] = distance;
+}
+
+size_t argxcSuggestFinish(ArgxcSuggest *suggest, const char **names)
+{
+    if (names)
+	{
+        for (size_t i = 0; i < suggest->count; i++) names[i] = suggest->names[i];
+    }
+
+    if (suggest->peq != suggest->inlineWords) free(suggest->peq);
+    suggest->peq = NULL;
+
+    return suggest->count;
+}
@@ -0,0 +1,58 @@
+/* src/ARGXSuggest.h
+ * Owned and created by: pcannon09
+ * Internal "did you mean" search: nearest names by bit-parallel edit distance
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../inc/macros.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+	// Search for the names nearest to one token. The token is the pattern of Myers'
+	// bit-vector algorithm, so each candidate costs one pass over its characters with
+	// 64 token characters per machine word.
+	typedef struct {
+    	size_t len;            // Token length
+    	size_t blocks;         // 64-bit words per column: (len + 63) / 64
+    	uint64_t *peq;         // [256][blocks]: bit i set where token[i] is the character
+    	uint64_t *pv;          // [blocks]: working column of the current candidate
+    	uint64_t *mv;
+    	size_t maxDistance;    // Names further than this are never suggested
+    	size_t max;            // Suggestions kept, at most ARGX_SUGGEST_MAX
+    	size_t count;
+    	const char *names[ARGX_SUGGEST_MAX];   // Closest first; ties keep the first offered
+    	size_t distances[ARGX_SUGGEST_MAX];
+    	uint64_t inlineWords[258]; // peq, pv and mv of tokens of up to 64 characters
+	} ArgxcSuggest;
+
+	/**
+ 	 * @brief Start a search for the names nearest to `token`.
+ 	 *
+ 	 * @param max Suggestions to keep (clamped to ARGX_SUGGEST_MAX).
+ 	 * @return false if memory allocation failed (tokens longer than 64 characters only).
+ 	 */
+	bool argxcSuggestInit(ArgxcSuggest *suggest, const char *token, size_t max);
+
+	/**
+ 	 * @brief Consider one candidate name; `name` must outlive the search. NULL and names
+ 	 * already kept are ignored.
+ 	 */
+	void argxcSuggestOffer(ArgxcSuggest *suggest, const char *name);
+
+	/**
+ 	 * @brief Copy the kept names, closest first, and release the search.
+ 	 *
+ 	 * @return size_t Number of names written to `names` (may be NULL to only count).
+ 	 */
+	size_t argxcSuggestFinish(ArgxcSuggest *suggest, const char **names);
+
+#ifdef __cplusplus
+}
+#endif
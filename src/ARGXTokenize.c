@@ -0,0 +1,207 @@
+/* src/ARGXTokenize.c
+ * Owned and created by: pcannon09
+ */
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <stdint.h>
+
+#include "../inc/ARGXTokenize.h"
+
+#include "ARGXTokenize.h"
+#include "ARGXStats.h"
+
+// Byte classes: anything not listed is copied as-is
+enum {
+    CHAR_PLAIN,
+    CHAR_BLANK,            // Ends the token (NUL too: it cannot live inside a C string)
+    CHAR_SPECIAL           // Quote or backslash
+};
+
+static const unsigned char charClass[256] = {
+    ['\0'] = CHAR_BLANK, [' '] = CHAR_BLANK, ['\t'] = CHAR_BLANK, ['\n'] = CHAR_BLANK,
+    ['\r'] = CHAR_BLANK, ['\v'] = CHAR_BLANK, ['\f'] = CHAR_BLANK,
+    ['\''] = CHAR_SPECIAL, ['"'] = CHAR_SPECIAL, ['\\'] = CHAR_SPECIAL
+};
+
+static bool pushArg(ArgxcTokens *tokens, char *arg)
+{
+    // One slot stays free for the closing NULL
+    if ((size_t)tokens->argc + 1 >= tokens->argvCapacity)
+	{
+        if (tokens->argc == INT_MAX - 1) return false;
+
+        size_t newCapacity = tokens->argvCapacity == 0 ? 64 : tokens->argvCapacity * 2;
+        char **argv = realloc(tokens->argv, newCapacity * sizeof(char *));
+        if (!argv) return false;
+
+        ARGX_STATS_ALLOC(newCapacity * sizeof(char *));
+
+        tokens->argv = argv;
+        tokens->argvCapacity = newCapacity;
+    }
+
+    tokens->argv[tokens->argc++] = arg;
+
+    return true;
+}
+
+// Leave `tokens` empty but usable after a failed call
+static ArgxcTokenizeStatus fail(ArgxcTokens *tokens, ArgxcTokenizeStatus status)
+{
+    tokens->argc = 0;
+    tokens->endOfOptions = -1;
+    if (tokens->argv) tokens->argv[0] = NULL;
+
+    return status;
+}
+
+static ArgxcTokenizeStatus tokenize(ArgxcTokens *tokens, const char *first, const char *line, size_t len)
+{
+    tokens->argc = 0;
+    tokens->endOfOptions = -1;
+
+    // Unquoting never grows a token and each token ends with at most one separator,
+    // so the unquoted tokens and their NULs fit in `len + 1` bytes
+    if (len == SIZE_MAX) return fail(tokens, ARGX_TOKENIZE_NO_MEMORY);
+
+    if (tokens->bufferCapacity < len + 1)
+	{
+        char *buffer = realloc(tokens->buffer, len + 1);
+        if (!buffer) return fail(tokens, ARGX_TOKENIZE_NO_MEMORY);
+
+        ARGX_STATS_ALLOC(len + 1);
+
+        tokens->buffer = buffer;
+        tokens->bufferCapacity = len + 1;
+    }
+
+    if (first && !pushArg(tokens, (char *)first)) return fail(tokens, ARGX_TOKENIZE_NO_MEMORY);
+
+    const unsigned char *in = (const unsigned char *)line;
+    const unsigned char *end = in + len;
+    char *out = tokens->buffer;
+
+    for (;;)
+	{
+        while (in < end)
+		{
+            if (charClass[*in] == CHAR_BLANK) in++;
+            else if (*in == '\\' && in + 1 < end && in[1] == '\n') in += 2; // Line continuation between tokens
+            else break;
+        }
+
+        if (in == end) break;
+
+        if (*in == '#')
+		{
+            const unsigned char *newline = memchr(in, '\n', (size_t)(end - in));
+            in = newline ? newline + 1 : end;
+            continue;
+        }
+
+        char *arg = out;
+        bool quoted = false;   // A quoted or escaped `--` is an ordinary argument
+
+        while (in < end && charClass[*in] != CHAR_BLANK)
+		{
+            if (charClass[*in] == CHAR_PLAIN)
+			{
+                const unsigned char *run = in;
+                while (in < end && charClass[*in] == CHAR_PLAIN) in++;
+
+                memcpy(out, run, (size_t)(in - run));
+                out += in - run;
+                continue;
+            }
+
+            unsigned char c = *in++;
+            quoted = true;
+
+            if (c == '\\')
+			{
+                if (in == end) return fail(tokens, ARGX_TOKENIZE_INCOMPLETE);
+                if (*in != '\n') *out++ = (char)*in;
+                in++;
+            }
+
+            else if (c == '\'')
+			{
+                const unsigned char *close = memchr(in, '\'', (size_t)(end - in));
+                if (!close) return fail(tokens, ARGX_TOKENIZE_INCOMPLETE);
+
+                memcpy(out, in, (size_t)(close - in));
+                out += close - in;
+                in = close + 1;
+            }
+
+            else
+			{
+                for (;;)
+				{
+                    if (in == end) return fail(tokens, ARGX_TOKENIZE_INCOMPLETE);
+
+                    c = *in++;
+                    if (c == '"') break;
+
+                    if (c == '\\' && in < end && (*in == '$' || *in == '`' || *in == '"' || *in == '\\' || *in == '\n'))
+					{
+                        if (*in != '\n') *out++ = (char)*in;
+                        in++;
+                    }
+                    else *out++ = (char)c;
+                }
+            }
+        }
+
+        *out++ = '\0';
+
+        if (!pushArg(tokens, arg)) return fail(tokens, ARGX_TOKENIZE_NO_MEMORY);
+
+        if (!quoted && tokens->endOfOptions < 0 && arg[0] == '-' && arg[1] == '-' && arg[2] == '\0')
+		{
+            tokens->endOfOptions = tokens->argc - 1;
+        }
+    }
+
+    // pushArg() keeps room for the closing NULL, but an empty line has not allocated it yet
+    if (!tokens->argv)
+	{
+        if (!pushArg(tokens, NULL)) return fail(tokens, ARGX_TOKENIZE_NO_MEMORY);
+        tokens->argc--;
+    }
+
+    tokens->argv[tokens->argc] = NULL;
+
+    return ARGX_TOKENIZE_OK;
+}
+
+ArgxcTokenizeStatus argxcTokenizeAfter(ArgxcTokens *tokens, const char *first, const char *line, size_t len)
+{
+    if (!tokens) return ARGX_TOKENIZE_NO_MEMORY;
+    if (!line) len = 0;
+
+    ARGX_TRACE_BEGIN(ARGX_TRACE_TOKENIZE);
+
+    ArgxcTokenizeStatus status = tokenize(tokens, first, line ? line : "", len);
+
+    ARGX_TRACE_END(ARGX_TRACE_TOKENIZE);
+
+    return status;
+}
+
+ArgxcTokenizeStatus argxcTokenize(ArgxcTokens *tokens, const char *line, size_t len)
+{
+    return argxcTokenizeAfter(tokens, NULL, line, len);
+}
+
+void argxcTokensFree(ArgxcTokens *tokens)
+{
+    if (!tokens) return;
+
+    free(tokens->argv);
+    free(tokens->buffer);
+    memset(tokens, 0, sizeof(ArgxcTokens));
+}
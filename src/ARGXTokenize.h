@@ -0,0 +1,25 @@
+/* src/ARGXTokenize.h
+ * Owned and created by: pcannon09
+ * Internal entry point of the command line tokenizer
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+#include "../inc/types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+	/**
+ 	 * @brief argxcTokenize(), optionally reserving argv[0] for `first` (e.g., the program name).
+ 	 *
+ 	 * @param first Stored as argv[0] when not NULL (borrowed, never written); the line's tokens follow it.
+ 	 */
+	ArgxcTokenizeStatus argxcTokenizeAfter(ArgxcTokens *tokens, const char *first, const char *line, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
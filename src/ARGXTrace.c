@@ -0,0 +1,244 @@
+/* src/ARGXTrace.c
+ * Owned and created by: pcannon09
+ */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#	define _GNU_SOURCE // syscall(SYS_gettid)
+#endif
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#	define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "../inc/ARGXTrace.h"
+#include "../inc/macros.h"
+
+#include "ARGXStats.h"
+
+#if ARGX_TRACE
+
+#include "ARGXAtomic.h"
+
+#if defined(_WIN32)
+#	include <windows.h>
+#else
+#	include <unistd.h>
+#	if defined(__linux__)
+#		include <sys/syscall.h>
+#	elif defined(__APPLE__)
+#		include <pthread.h>
+#	endif
+#endif
+
+// One event; the fields are accessed atomically so the writer can read while threads record
+typedef struct {
+    uint64_t sequence;     // Position + 1 once the event is complete, 0 while it is written
+    uint64_t timestamp;    // Nanoseconds (argxcStatsNow)
+    uint64_t info;         // Event | phase << 8 | thread << 32
+} ArgxcTraceSlot;
+
+typedef struct {
+    uint64_t head;         // Positions reserved so far
+    uint64_t mask;         // Capacity - 1
+    ArgxcTraceSlot slots[];
+} ArgxcTraceRing;
+
+static const char *const traceNames[ARGX_TRACE_EVENT_COUNT] = {
+    "argxcCreate",
+    "argxcResponseExpand",
+    "argxcTokenize",
+    "argxcAddOption",
+    "argxcAddSubOption",
+    "argxcParse",
+    "argxcSpecCreate",
+    "argxcSpecParse",
+    "argxcClassifyTokens",
+    "argxcFindParam",
+    "argxcGetParam",
+    "argxcGetSubParam",
+    "argxcCompareArgs",
+    "argxcDiagnoseBatch",
+    "argxcCreateDocs"
+};
+
+static ArgxcTraceRing *traceRing = NULL;
+static uint64_t traceEnabled = 0;
+
+#if !defined(_WIN32) && !defined(__linux__) && !defined(__APPLE__)
+static uint64_t traceThreads = 0;
+#endif
+
+static uint64_t currentThread(void)
+{
+    static ARGX_THREAD_LOCAL uint64_t thread = 0;
+
+    if (!thread)
+	{
+#if defined(_WIN32)
+        thread = GetCurrentThreadId();
+#elif defined(__linux__)
+        thread = (uint64_t)syscall(SYS_gettid);
+#elif defined(__APPLE__)
+        pthread_threadid_np(NULL, &thread);
+#else
+        thread = ARGX_ATOMIC_FETCH_ADD(&traceThreads, 1) + 1;
+#endif
+    }
+
+    return thread;
+}
+
+static unsigned long currentProcess(void)
+{
+#if defined(_WIN32)
+    return (unsigned long)GetCurrentProcessId();
+#else
+    return (unsigned long)getpid();
+#endif
+}
+
+void argxcTraceRecord(ArgxcTraceEvent event, char phase)
+{
+    if (!ARGX_ATOMIC_LOAD_ACQUIRE(&traceEnabled)) return;
+
+    ArgxcTraceRing *ring = traceRing;
+    uint64_t info = (uint64_t)event | (uint64_t)(unsigned char)phase << 8 | (currentThread() & 0xffffffffu) << 32;
+    uint64_t timestamp = argxcStatsNow();
+
+    uint64_t position = ARGX_ATOMIC_FETCH_ADD(&ring->head, 1);
+    ArgxcTraceSlot *slot = &ring->slots[position & ring->mask];
+
+    // Seqlock: a reader keeps the slot only if it sees the same published sequence before and after
+    ARGX_ATOMIC_STORE(&slot->sequence, 0);
+    ARGX_ATOMIC_FENCE_RELEASE();
+    ARGX_ATOMIC_STORE(&slot->timestamp, timestamp);
+    ARGX_ATOMIC_STORE(&slot->info, info);
+    ARGX_ATOMIC_STORE_RELEASE(&slot->sequence, position + 1);
+}
+
+bool argxcTraceStart(size_t capacity)
+{
+    if (capacity == 0) capacity = ARGX_TRACE_DEFAULT_CAPACITY;
+    if (capacity > (SIZE_MAX - sizeof(ArgxcTraceRing)) / sizeof(ArgxcTraceSlot) / 2) return false;
+
+    size_t slots = 1;
+    while (slots < capacity) slots <<= 1;
+
+    ARGX_ATOMIC_STORE_RELEASE(&traceEnabled, 0);
+
+    if (!traceRing || traceRing->mask + 1 != slots)
+	{
+        free(traceRing);
+        traceRing = malloc(sizeof(ArgxcTraceRing) + slots * sizeof(ArgxcTraceSlot));
+        if (!traceRing) return false;
+
+        traceRing->mask = slots - 1;
+    }
+
+    traceRing->head = 0;
+    memset(traceRing->slots, 0, slots * sizeof(ArgxcTraceSlot));
+
+    ARGX_ATOMIC_STORE_RELEASE(&traceEnabled, 1);
+
+    return true;
+}
+
+void argxcTraceStop(void)
+{
+    ARGX_ATOMIC_STORE_RELEASE(&traceEnabled, 0);
+}
+
+bool argxcTraceWrite(ArgxcDocsSink sink, void *userData)
+{
+    static const char header[] = "{\"traceEvents\":[";
+    static const char footer[] = "\n],\"displayTimeUnit\":\"ns\"}\n";
+
+    if (!sink) return false;
+
+    bool ok = sink(userData, header, sizeof(header) - 1);
+    ArgxcTraceRing *ring = traceRing;
+
+    if (ok && ring)
+	{
+        uint64_t head = ARGX_ATOMIC_LOAD_ACQUIRE(&ring->head);
+        uint64_t first = head > ring->mask + 1 ? head - (ring->mask + 1) : 0;
+        unsigned long process = currentProcess();
+        bool firstEvent = true;
+
+        for (uint64_t position = first; ok && position < head; position++)
+		{
+            ArgxcTraceSlot *slot = &ring->slots[position & ring->mask];
+
+            uint64_t sequence = ARGX_ATOMIC_LOAD_ACQUIRE(&slot->sequence);
+            uint64_t timestamp = ARGX_ATOMIC_LOAD(&slot->timestamp);
+            uint64_t info = ARGX_ATOMIC_LOAD(&slot->info);
+            ARGX_ATOMIC_FENCE_ACQUIRE();
+
+            // Still being written, or already reused by a newer event
+            if (sequence != position + 1 || ARGX_ATOMIC_LOAD(&slot->sequence) != sequence) continue;
+
+            unsigned int event = (unsigned int)(info & 0xff);
+            if (event >= ARGX_TRACE_EVENT_COUNT) continue;
+
+            char line[192];
+            int len = snprintf(line, sizeof(line),
+                	"%s{\"name\":\"%s\",\"cat\":\"argxc\",\"ph\":\"%c\",\"ts\":%llu.%03u,\"pid\":%lu,\"tid\":%lu}",
+                	firstEvent ? "\n" : ",\n", traceNames[event], (char)((info >> 8) & 0xff),
+                	(unsigned long long)(timestamp / 1000), (unsigned int)(timestamp % 1000),
+                	process, (unsigned long)(info >> 32));
+
+            ok = len > 0 && sink(userData, line, (size_t)len);
+            firstEvent = false;
+        }
+    }
+
+    return ok && sink(userData, footer, sizeof(footer) - 1);
+}
+
+void argxcTraceRelease(void)
+{
+    ARGX_ATOMIC_STORE_RELEASE(&traceEnabled, 0);
+
+    free(traceRing); traceRing = NULL;
+}
+
+#else
+
+bool argxcTraceStart(size_t capacity)
+{
+    (void)capacity;
+    return false;
+}
+
+void argxcTraceStop(void)
+{
+}
+
+bool argxcTraceWrite(ArgxcDocsSink sink, void *userData)
+{
+    (void)sink;
+    (void)userData;
+    return false;
+}
+
+void argxcTraceRelease(void)
+{
+}
+
+#endif
+
+static bool fileSink(void *userData, const char *data, size_t len)
+{
+    return fwrite(data, 1, len, (FILE *)userData) == len;
+}
+
+bool argxcTraceWriteToFile(FILE *file)
+{
+    if (!file) return false;
+
+    return argxcTraceWrite(fileSink, file);
+}
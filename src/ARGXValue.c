@@ -0,0 +1,217 @@
+/* src/ARGXValue.c
+ * Owned and created by: pcannon09
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+
+#include "ARGXValue.h"
+
+// Significant digits kept before falling back to strtod(). No midpoint between two doubles
+// has more than 767, so these plus a sticky digit for the rest always round correctly.
+#define ARGX_VALUE_MAX_DIGITS 768
+
+static bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+static char lowerAscii(char c)
+{
+    return c >= 'A' && c <= 'Z' ? (char)(c - 'A' + 'a') : c;
+}
+
+static bool equalsIgnoreCase(const char *str, const char *word)
+{
+    for (; *word; str++, word++)
+	{
+        if (lowerAscii(*str) != *word) return false;
+    }
+
+    return *str == '\0';
+}
+
+// Unsigned digits up to `limit`; the whole remaining string must be digits
+static bool parseDigits(const char *str, uint64_t limit, uint64_t *out)
+{
+    uint64_t value = 0;
+
+    if (!isDigit(*str)) return false;
+
+    for (; *str; str++)
+	{
+        if (!isDigit(*str)) return false;
+
+        uint64_t digit = (uint64_t)(*str - '0');
+        if (value > (limit - digit) / 10) return false;
+
+        value = value * 10 + digit;
+    }
+
+    *out = value;
+
+    return true;
+}
+
+bool argxcValueParseInt64(const char *str, int64_t *out)
+{
+    if (!str) return false;
+
+    bool negative = *str == '-';
+    if (*str == '-' || *str == '+') str++;
+
+    uint64_t magnitude = 0;
+    if (!parseDigits(str, negative ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX, &magnitude)) return false;
+
+    *out = negative ? (int64_t)(0 - magnitude) : (int64_t)magnitude;
+
+    return true;
+}
+
+bool argxcValueParseUint64(const char *str, uint64_t *out)
+{
+    if (!str) return false;
+    if (*str == '+') str++;
+
+    return parseDigits(str, UINT64_MAX, out);
+}
+
+bool argxcValueParseDouble(const char *str, double *out)
+{
+    static const double powers[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    if (!str) return false;
+
+    const char *p = str;
+    bool negative = *p == '-';
+    if (*p == '-' || *p == '+') p++;
+
+    if (equalsIgnoreCase(p, "inf") || equalsIgnoreCase(p, "infinity"))
+	{
+        *out = negative ? -HUGE_VAL : HUGE_VAL;
+        return true;
+    }
+
+    if (equalsIgnoreCase(p, "nan"))
+	{
+        *out = NAN;
+        return true;
+    }
+
+    // Significant digits without the decimal point, scaled by 10^exponent
+    char digits[ARGX_VALUE_MAX_DIGITS + 32];
+    size_t count = 0;
+    long exponent = 0;
+    bool any = false;
+    bool sticky = false; // A nonzero digit was dropped
+
+    for (; isDigit(*p); p++)
+	{
+        any = true;
+
+        if (count == 0 && *p == '0') continue;
+        if (count < ARGX_VALUE_MAX_DIGITS) digits[count++] = *p;
+        else
+		{
+            sticky |= *p != '0';
+            exponent++;
+        }
+    }
+
+    if (*p == '.')
+	{
+        for (p++; isDigit(*p); p++)
+		{
+            any = true;
+
+            if (count == 0 && *p == '0') exponent--;
+            else if (count < ARGX_VALUE_MAX_DIGITS)
+			{
+                digits[count++] = *p;
+                exponent--;
+            }
+            else sticky |= *p != '0';
+        }
+    }
+
+    if (!any) return false;
+
+    // The dropped digits only matter as "more than what was kept": one nonzero digit says so
+    if (sticky)
+	{
+        digits[count++] = '1';
+        exponent--;
+    }
+
+    if (*p == 'e' || *p == 'E')
+	{
+        p++;
+
+        bool negativeExponent = *p == '-';
+        if (*p == '-' || *p == '+') p++;
+        if (!isDigit(*p)) return false;
+
+        long value = 0;
+
+        for (; isDigit(*p); p++)
+		{
+            if (value < 100000) value = value * 10 + (*p - '0');
+        }
+
+        exponent += negativeExponent ? -value : value;
+    }
+
+    if (*p != '\0') return false;
+
+    double result = 0.0;
+
+    if (count == 0) result = 0.0;
+    else if (count <= 15 && exponent >= -22 && exponent <= 22)
+	{
+        // Exact mantissa and power of ten: a single correctly rounded operation
+        uint64_t mantissa = 0;
+
+        for (size_t i = 0; i < count; i++) mantissa = mantissa * 10 + (uint64_t)(digits[i] - '0');
+
+        result = exponent < 0 ? (double)mantissa / powers[-exponent] : (double)mantissa * powers[exponent];
+    }
+    else
+	{
+        // Digits and exponent only: no decimal point, so strtod() cannot be affected by the locale
+        int written = snprintf(digits + count, sizeof(digits) - count, "e%ld", exponent);
+        if (written < 0) return false;
+
+        result = strtod(digits, NULL);
+
+        // Beyond the range of double: infinity or zero would not be the number given
+        if (isinf(result) || result == 0.0) return false;
+    }
+
+    *out = negative ? -result : result;
+
+    return true;
+}
+
+bool argxcValueParseBool(const char *str, bool *out)
+{
+    if (!str) return false;
+
+    if (equalsIgnoreCase(str, "true") || equalsIgnoreCase(str, "yes") || equalsIgnoreCase(str, "on") || strcmp(str, "1") == 0)
+	{
+        *out = true;
+        return true;
+    }
+
+    if (equalsIgnoreCase(str, "false") || equalsIgnoreCase(str, "no") || equalsIgnoreCase(str, "off") || strcmp(str, "0") == 0)
+	{
+        *out = false;
+        return true;
+    }
+
+    return false;
+}
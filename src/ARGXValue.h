@@ -0,0 +1,47 @@
+/* src/ARGXValue.h
+ * Owned and created by: pcannon09
+ * Internal locale-independent conversions for typed option values
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+	/**
+ 	 * @brief Convert a decimal integer (optional sign) to int64_t.
+ 	 *
+ 	 * @return false on an empty string, a stray character or an overflow.
+ 	 */
+	bool argxcValueParseInt64(const char *str, int64_t *out);
+
+	/**
+ 	 * @brief Convert a decimal integer (optional '+') to uint64_t.
+ 	 *
+ 	 * @return false on an empty string, a stray character or an overflow.
+ 	 */
+	bool argxcValueParseUint64(const char *str, uint64_t *out);
+
+	/**
+ 	 * @brief Convert a decimal floating-point number ('.' separator whatever the locale,
+ 	 * optional exponent, `inf`/`nan`) to double.
+ 	 *
+ 	 * @return false if the whole string is not a number, or its magnitude overflows or
+ 	 * underflows to zero.
+ 	 */
+	bool argxcValueParseDouble(const char *str, double *out);
+
+	/**
+ 	 * @brief Convert true/false, yes/no, on/off or 1/0 (any case) to bool.
+ 	 *
+ 	 * @return false for any other text.
+ 	 */
+	bool argxcValueParseBool(const char *str, bool *out);
+
+#ifdef __cplusplus
+}
+#endif
@@ -10,16 +10,47 @@
 
 #include "../inc/Argx.h"
 #include "../inc/types.h"
+#include "../inc/macros.h"
+
+#include "ARGXAtomic.h"
+#include "ARGXClassify.h"
+#include "ARGXIndex.h"
+#include "ARGXIntern.h"
+#include "ARGXParse.h"
+#include "ARGXPool.h"
+#include "ARGXResponse.h"
+#include "ARGXStats.h"
+#include "ARGXSuggest.h"
+#include "ARGXTokenize.h"
+#include "ARGXValue.h"
+
+// Option count from which argxcCompareArgs() builds a temporary hash index
+#define ARGX_COMPARE_INDEX_THRESHOLD 16
 
 // Internal structure definition
 struct Argxc {
     char *id;
     char **mainArgs;
     size_t mainArgsCount;
+    bool borrowedArgs;     // `mainArgs` is the caller's argv (see argxcCreateBorrowed)
+    ArgxcResponseFiles *responseFiles; // Files backing expanded `mainArgs` (the array itself is owned)
+    ArgxcTokens *tokens;   // Tokenized command string backing `mainArgs` (see argxcCreateFromString)
     unsigned int mainArgc;
     ArgxcOptions *options;
     size_t optionsCount;
     size_t optionsCapacity;
+    ArgxcArena *arena;     // Owns every allocation of the instance, NULL for the C heap
+    unsigned int flags;    // ArgxcFlags
+    ArgxcSpec *spec;       // Compiled `options`, NULL until parsed (or after a change)
+    ArgxcResult *result;   // `mainArgs` parsed against `spec`
+    const ArgxcOptions **actionSources; // Option of each `spec` node, collected by the first argxcDispatch()
+    ArgxcActionBinding *actions;         // Action of each `spec` node, refreshed by every argxcDispatch()
+    size_t actionsCount;
+    bool argsReset;        // argxcReset() replaced `mainArgs`: the next parse reuses `spec` and `result`
+#if ARGX_STATS
+    ArgxcStats stats;
+    uint64_t statsSerial;  // Registration of `stats` as the default of the creating thread
+#endif
 };
 
 // Static helper functions
@@ -28,6 +59,7 @@ static char *stringDuplicate(const char *str)
     if (!str) return NULL;
     size_t len = strlen(str) + 1;
     char *dup = malloc(len);
+    ARGX_STATS_ALLOC(len);
     if (dup)
 	{
         memcpy(dup, str, len);
@@ -47,523 +79,1293 @@ static void freeStringArray(char **array, size_t count)
 	{ free(array); array = NULL; }
 }
 
-static void freeOptionsArray(ArgxcOptions *options, size_t count)
+// Drop the compiled spec and its result; the next lookup parses again
+static void invalidateParse(Argxc *argxc)
 {
-    if (!options) return;
+    argxcResultDestroy(argxc->result); argxc->result = NULL;
+    argxcSpecDestroy(argxc->spec); argxc->spec = NULL;
+    free(argxc->actionSources); argxc->actionSources = NULL;
+    free(argxc->actions); argxc->actions = NULL;
+    argxc->actionsCount = 0;
+    argxc->argsReset = false;
+}
 
-    for (size_t i = 0; i < count; i++)
+static bool ensureParsed(Argxc *argxc)
+{
+    return (argxc->result && !argxc->argsReset) || argxcParse(argxc);
+}
+
+// Free whatever backs `mainArgs` (arena copies stay until argxcDestroy())
+static void releaseArgs(Argxc *argxc)
+{
+    if (!argxc->arena)
 	{
-        if (&options[i]) argxcFreeOption(&options[i]);
+        if (argxc->mainArgs && !argxc->borrowedArgs) freeStringArray(argxc->mainArgs, argxc->mainArgsCount);
+
+        if (argxc->responseFiles)
+		{
+            free(argxc->mainArgs);
+            argxcResponseRelease(argxc->responseFiles);
+            free(argxc->responseFiles);
+        }
+
+        if (argxc->tokens)
+		{
+            argxcTokensFree(argxc->tokens);
+            free(argxc->tokens);
+        }
     }
 
-	if (options)
-	{ free(options); options = NULL; }
+    argxc->mainArgs = NULL;
+    argxc->responseFiles = NULL;
+    argxc->tokens = NULL;
 }
 
 // Constructor/Destructor implementations
-Argxc *argxcCreate(const char *id, int argc, char *argv[])
+static Argxc *buildInstance(const char *id, int argc, char *argv[], ArgxcArena *arena, bool borrowArgs)
 {
-    Argxc *argxc = malloc(sizeof(Argxc));
+    Argxc *argxc = argxcArenaAlloc(arena, sizeof(Argxc));
     if (!argxc) return NULL;
 
-    argxc->id = stringDuplicate(id);
+    argxc->arena = arena;
+    argxc->id = argxcArenaStrdup(arena, id);
     argxc->mainArgc = argc;
     argxc->mainArgsCount = argc;
-    argxc->mainArgs = malloc(argc * sizeof(char*));
+    argxc->borrowedArgs = borrowArgs;
+    argxc->responseFiles = NULL;
+    argxc->tokens = NULL;
+    argxc->mainArgs = borrowArgs ? argv : argxcArenaAlloc(arena, argc * sizeof(char*));
+    argxc->optionsCount = 0;
+    argxc->optionsCapacity = 10;
+    argxc->options = argxcArenaAlloc(arena, argxc->optionsCapacity * sizeof(ArgxcOptions));
+    argxc->flags = ARGX_FLAG_NONE;
+    argxc->spec = NULL;
+    argxc->result = NULL;
+    argxc->actionSources = NULL;
+    argxc->actions = NULL;
+    argxc->actionsCount = 0;
+    argxc->argsReset = false;
+#if ARGX_STATS
+    argxc->statsSerial = 0;
+#endif
+
+    if (!argxc->mainArgs || !argxc->options)
+	{
+        argxcDestroy(argxc);
+        return NULL;
+    }
+
+    for (int i = 0; !borrowArgs && i < argc; i++)
+	{
+        argxc->mainArgs[i] = argxcArenaStrdup(arena, argv[i]);
+    }
+
+    return argxc;
+}
+
+static Argxc *createInstance(const char *id, int argc, char *argv[], ArgxcArena *arena, bool borrowArgs)
+{
+    ARGX_TRACE_BEGIN(ARGX_TRACE_CREATE);
+
+#if ARGX_STATS
+    // The instance does not exist until built: count into a local copy, kept once it does
+    ArgxcStats stats = {0};
+    ARGX_STATS_BEGIN(&stats);
+
+    Argxc *argxc = buildInstance(id, argc, argv, arena, borrowArgs);
+
+    ARGX_STATS_END(createNs);
+
+    if (argxc)
+	{
+        argxc->stats = stats;
+        argxc->statsSerial = argxcStatsSetDefault(&argxc->stats);
+    }
+#else
+    Argxc *argxc = buildInstance(id, argc, argv, arena, borrowArgs);
+#endif
+
+    ARGX_TRACE_END(ARGX_TRACE_CREATE);
+
+    return argxc;
+}
+
+Argxc *argxcCreate(const char *id, int argc, char *argv[])
+{
+    return createInstance(id, argc, argv, NULL, false);
+}
+
+Argxc *argxcCreateBorrowed(const char *id, int argc, char *argv[])
+{
+    if (argc > 0 && !argv) return NULL;
+
+    return createInstance(id, argc, argv, NULL, true);
+}
+
+Argxc *argxcCreateWithArena(const char *id, int argc, char *argv[])
+{
+    ArgxcArena *arena = argxcArenaCreate(0);
+    if (!arena) return NULL;
+
+    Argxc *argxc = createInstance(id, argc, argv, arena, false);
+    if (!argxc) argxcArenaDestroy(arena);
+
+    return argxc;
+}
+
+Argxc *argxcCreateWithResponseFiles(const char *id, int argc, char *argv[], int maxDepth)
+{
+    if (argc > 0 && !argv) return NULL;
+
+    ArgxcResponseFiles *files = calloc(1, sizeof(ArgxcResponseFiles));
+    if (!files) return NULL;
+
+#if ARGX_STATS
+    ArgxcStats stats = {0};
+    ARGX_STATS_BEGIN(&stats);
+#endif
+
+    char **args = NULL;
+    size_t count = 0;
+
+    ARGX_TRACE_BEGIN(ARGX_TRACE_RESPONSE_FILES);
+    bool expanded = argxcResponseExpand(files, argc, argv, maxDepth > 0 ? maxDepth : ARGX_RESPONSE_MAX_DEPTH, &args, &count);
+    ARGX_TRACE_END(ARGX_TRACE_RESPONSE_FILES);
+
+    ARGX_STATS_END(createNs);
+
+    if (!expanded)
+	{
+        argxcResponseRelease(files);
+        free(files); files = NULL;
+        return NULL;
+    }
+
+    Argxc *argxc = createInstance(id, (int)count, args, NULL, true);
+
+    if (!argxc)
+	{
+        free(args); args = NULL;
+        argxcResponseRelease(files);
+        free(files); files = NULL;
+        return NULL;
+    }
+
+    argxc->responseFiles = files;
+
+#if ARGX_STATS
+    argxcStatsMerge(&argxc->stats, &stats);
+#endif
+
+    return argxc;
+}
+
+Argxc *argxcCreateFromString(const char *id, const char *line)
+{
+    if (!line) return NULL;
+
+    ArgxcTokens *tokens = calloc(1, sizeof(ArgxcTokens));
+    if (!tokens) return NULL;
+
+#if ARGX_STATS
+    ArgxcStats stats = {0};
+    ARGX_STATS_BEGIN(&stats);
+#endif
+
+    // argv[0] is patched to the instance's own copy of `id` once it exists
+    ArgxcTokenizeStatus status = argxcTokenizeAfter(tokens, "", line, strlen(line));
+
+    ARGX_STATS_END(createNs);
+
+    if (status != ARGX_TOKENIZE_OK)
+	{
+        argxcTokensFree(tokens);
+        free(tokens); tokens = NULL;
+        return NULL;
+    }
+
+    Argxc *argxc = createInstance(id, tokens->argc, tokens->argv, NULL, true);
+
+    if (!argxc)
+	{
+        argxcTokensFree(tokens);
+        free(tokens); tokens = NULL;
+        return NULL;
+    }
+
+    if (argxc->id) tokens->argv[0] = argxc->id;
+    argxc->tokens = tokens;
+
+#if ARGX_STATS
+    argxcStatsMerge(&argxc->stats, &stats);
+#endif
+
+    return argxc;
+}
+
+Argxc *argxcCreateDefault(void)
+{
+    Argxc *argxc = malloc(sizeof(Argxc));
+    if (!argxc) return NULL;
+
+    argxc->arena = NULL;
+    argxc->id = NULL;
+    argxc->mainArgs = NULL;
+    argxc->mainArgsCount = 0;
+    argxc->borrowedArgs = false;
+    argxc->responseFiles = NULL;
+    argxc->tokens = NULL;
+    argxc->mainArgc = 0;
     argxc->optionsCount = 0;
     argxc->optionsCapacity = 10;
     argxc->options = malloc(argxc->optionsCapacity * sizeof(ArgxcOptions));
+    argxc->flags = ARGX_FLAG_NONE;
+    argxc->spec = NULL;
+    argxc->result = NULL;
+    argxc->actionSources = NULL;
+    argxc->actions = NULL;
+    argxc->actionsCount = 0;
+    argxc->argsReset = false;
+
+#if ARGX_STATS
+    memset(&argxc->stats, 0, sizeof(argxc->stats));
+    argxc->stats.allocations = 2;
+    argxc->stats.allocatedBytes = sizeof(Argxc) + argxc->optionsCapacity * sizeof(ArgxcOptions);
+#endif
+
+    if (!argxc->options)
+	{
+        free(argxc); argxc = NULL;
+        return NULL;
+    }
+
+#if ARGX_STATS
+    argxc->statsSerial = argxcStatsSetDefault(&argxc->stats);
+#endif
+
+    return argxc;
+}
+
+void argxcDestroy(Argxc *argxc)
+{
+    if (!argxc) return;
+
+    invalidateParse(argxc);
+
+#if ARGX_STATS
+    argxcStatsDropDefault(argxc->statsSerial);
+#endif
+
+    // Options created on the C heap may have been added to an arena instance
+    if (argxc->options)
+	{
+        for (size_t i = 0; i < argxc->optionsCount; i++)
+		{
+            argxcFreeOption(&argxc->options[i]);
+        }
+    }
+
+    if (argxc->arena)
+	{
+        // Everything else (including the instance itself) lives in the arena
+        argxcArenaDestroy(argxc->arena);
+        return;
+    }
+
+    free(argxc->id); argxc->id = NULL;
+    releaseArgs(argxc);
+    free(argxc->options); argxc->options = NULL;
+    free(argxc); argxc = NULL;
+}
+
+// Core functionality implementations
+
+// Index one string of an option; interned handles bring their length and hash
+static bool indexString(ArgxcIndex *index, ArgxcIndexKind kind, const ArgxcOptions *option, const char *key, size_t slot)
+{
+    if (!key || !option->interned) return argxcIndexInsert(index, kind, key, slot);
+
+    const ArgxcInternHeader *header = ARGX_INTERN_HEADER(key);
+
+    return argxcIndexInsertHashed(index, kind, key, header->length, header->hash, slot);
+}
+
+static bool indexSubOption(ArgxcIndex *index, const ArgxcOptions *subOption, size_t slot)
+{
+    return indexString(index, ARGX_INDEX_ID, subOption, subOption->id, slot) &&
+        indexString(index, ARGX_INDEX_NAME, subOption, subOption->param, slot) &&
+        indexString(index, ARGX_INDEX_NAME, subOption, subOption->sparam, slot);
+}
+
+// Index over the sub-options of an option, with the state of adoptOption()
+typedef struct {
+    ArgxcIndex index;      // First, so ArgxcOptions::subIndex points at it
+    bool held;             // The option was added to a parent or an instance
+} ArgxcChildIndex;
+
+static bool adoptOption(ArgxcOptions *option);
+
+// Any handle of a heap option, locating the block that holds all of them (NULL if none)
+static const char *optionStrings(const ArgxcOptions *option)
+{
+    if (option->id) return option->id;
+    if (option->param) return option->param;
+    if (option->sparam) return option->sparam;
+
+    return option->info;
+}
+
+// Give a heap option its own copy of its children (see adoptOption()); false if memory
+// allocation failed, leaving the option as it was
+static bool copyChildren(ArgxcOptions *option)
+{
+    size_t count = option->subParamsCount;
+    ArgxcOptions *children = malloc((count ? count : 1) * sizeof(ArgxcOptions));
+    ArgxcChildIndex *index = calloc(1, sizeof(ArgxcChildIndex));
+    size_t adopted = 0;
+    bool ok = children && index;
+
+    if (children) ARGX_STATS_ALLOC((count ? count : 1) * sizeof(ArgxcOptions));
+    if (index) ARGX_STATS_ALLOC(sizeof(ArgxcChildIndex));
+
+    while (ok && adopted < count)
+	{
+        children[adopted] = option->subParams[adopted];
+        ok = adoptOption(&children[adopted]);
+        if (ok) adopted++;
+    }
+
+    for (size_t i = 0; ok && i < count; i++) ok = indexSubOption(&index->index, &children[i], i);
+
+    if (!ok)
+	{
+        for (size_t i = 0; i < adopted; i++) argxcFreeOption(&children[i]);
+
+        if (index) argxcIndexFree(&index->index);
+        free(index); index = NULL;
+        free(children); children = NULL;
+        return false;
+    }
+
+    index->held = true;
+
+    option->subParams = children;
+    option->subParamsCapacity = count ? count : 1;
+    option->subIndex = &index->index;
+
+    return true;
+}
+
+// Every holder (instance or parent option) frees the options it holds. An option added a
+// second time, like a sub-option under several commands, first gets its own copy of its
+// children and one more reference to its strings, so every holder frees them exactly once.
+// Copies of an option share its child index and string block, which record that the option
+// is already held.
+static bool adoptOption(ArgxcOptions *option)
+{
+    // Arena memory is never freed one block at a time
+    if (!option->interned || option->arena) return true;
+
+    ArgxcChildIndex *index = (ArgxcChildIndex *)option->subIndex;
+
+    if (index && index->held)
+	{
+        if (!copyChildren(option)) return false;
+    }
+    else if (index) index->held = true;
+
+    const char *strings = optionStrings(option);
+    if (strings) argxcInternAdopt(strings);
+
+    return true;
+}
+
+static void addOption(Argxc *argxc, ArgxcOptions option)
+{
+    if (argxc->optionsCount >= argxc->optionsCapacity)
+	{
+        ArgxcOptions *newOptions = argxcArenaRealloc(argxc->arena, argxc->options,
+                argxc->optionsCapacity * sizeof(ArgxcOptions), argxc->optionsCapacity * 2 * sizeof(ArgxcOptions));
+        if (!newOptions) return;
+
+        argxc->options = newOptions;
+        argxc->optionsCapacity *= 2;
+    }
+
+    if (!adoptOption(&option)) return;
+
+    argxc->options[argxc->optionsCount++] = option;
+    invalidateParse(argxc);
+}
+
+void argxcAddOption(Argxc *argxc, ArgxcOptions option)
+{
+    if (!argxc) return;
+
+    ARGX_TRACE_BEGIN(ARGX_TRACE_ADD_OPTION);
+    addOption(argxc, option);
+    ARGX_TRACE_END(ARGX_TRACE_ADD_OPTION);
+}
+
+static void addSubOption(ArgxcOptions *parent, ArgxcOptions subOption)
+{
+    if (parent->subParamsCount >= parent->subParamsCapacity)
+	{
+        size_t newCapacity = parent->subParamsCapacity == 0 ? 2 : parent->subParamsCapacity * 2;
+        ArgxcOptions *newSubParams = argxcArenaRealloc(parent->arena, parent->subParams,
+                parent->subParamsCapacity * sizeof(ArgxcOptions), newCapacity * sizeof(ArgxcOptions));
+        if (!newSubParams) return;
+
+        parent->subParams = newSubParams;
+        parent->subParamsCapacity = newCapacity;
+    }
+
+    if (!parent->subIndex)
+	{
+        parent->subIndex = argxcArenaCalloc(parent->arena, 1, sizeof(ArgxcChildIndex));
+        if (!parent->subIndex) return;
+
+        parent->subIndex->arena = parent->arena;
+    }
+
+    if (!adoptOption(&subOption)) return;
+
+    size_t slot = parent->subParamsCount;
+
+    parent->subParams[parent->subParamsCount++] = subOption;
+
+    indexSubOption(parent->subIndex, &subOption, slot);
+}
+
+void argxcAddSubOption(ArgxcOptions *parent, ArgxcOptions subOption)
+{
+    if (!parent) return;
+
+    ARGX_TRACE_BEGIN(ARGX_TRACE_ADD_SUB_OPTION);
+    addSubOption(parent, subOption);
+    ARGX_TRACE_END(ARGX_TRACE_ADD_SUB_OPTION);
+}
+
+// Option of every spec node. Nodes are numbered breadth-first (top-level options, then the
+// children of each node in turn), so replaying that order pairs each node with its option.
+// Kept with the spec, so later dispatches only refresh the bindings (see refreshActions()).
+static bool collectActions(Argxc *argxc, size_t nodesCount)
+{
+    size_t capacity = nodesCount ? nodesCount : 1;
+    const ArgxcOptions **sources = malloc(capacity * sizeof(ArgxcOptions *));
+    ArgxcActionBinding *actions = malloc(capacity * sizeof(ArgxcActionBinding));
+
+    if (!sources || !actions)
+	{
+        free(sources); sources = NULL;
+        free(actions); actions = NULL;
+        return false;
+    }
+
+    ARGX_STATS_ALLOC(capacity * sizeof(ArgxcOptions *));
+    ARGX_STATS_ALLOC(capacity * sizeof(ArgxcActionBinding));
+
+    size_t count = 0;
+
+    for (size_t i = 0; i < argxc->optionsCount && count < nodesCount; i++)
+	{
+        sources[count++] = &argxc->options[i];
+    }
+
+    for (size_t i = 0; i < count; i++)
+	{
+        for (size_t j = 0; j < sources[i]->subParamsCount && count < nodesCount; j++)
+		{
+            sources[count++] = &sources[i]->subParams[j];
+        }
+    }
+
+    argxc->actionSources = sources;
+    argxc->actions = actions;
+    argxc->actionsCount = count;
+
+    return true;
+}
+
+// Copy the current action of every node: argxcSetOptionAction() may have run since the last dispatch
+static void refreshActions(Argxc *argxc)
+{
+    for (size_t i = 0; i < argxc->actionsCount; i++)
+	{
+        argxc->actions[i].action = argxc->actionSources[i]->action;
+        argxc->actions[i].userData = argxc->actionSources[i]->actionData;
+    }
+}
+
+static bool parseInstance(Argxc *argxc, bool dispatch)
+{
+    if (!argxc) return false;
+
+    // After argxcReset() the options are unchanged: rescan into the compiled spec and result
+    bool reuse = argxc->argsReset && argxc->spec && argxc->result;
+
+    if (!reuse) invalidateParse(argxc);
+    argxc->argsReset = false;
+
+    ARGX_TRACE_BEGIN(ARGX_TRACE_PARSE);
+    ARGX_STATS_BEGIN(&argxc->stats);
+
+    if (!argxc->spec) argxc->spec = argxcSpecCreateIn(argxc->arena, argxc->options, argxc->optionsCount, argxc->flags);
+
+    if (argxc->spec && dispatch && (argxc->actions || collectActions(argxc, argxcSpecGetNodesCount(argxc->spec))))
+	{
+        refreshActions(argxc);
+    }
+
+    if (argxc->spec && (!dispatch || argxc->actions))
+	{
+        const ArgxcActionBinding *actions = dispatch ? argxc->actions : NULL;
+
+        // A tokenized string knows which `--` was quoted; in argv from main() any ends the options
+        int endOfOptions = argxc->tokens ? argxc->tokens->endOfOptions : 0;
+
+        if (reuse)
+		{
+            ArgxcResult *result = argxcResultReparseLine(argxc->result, (int)argxc->mainArgsCount, argxc->mainArgs,
+                    actions, endOfOptions);
+
+            if (!result) argxcResultDestroy(argxc->result);
+            argxc->result = result;
+        }
+        else
+		{
+            argxc->result = argxcSpecParseLine(argxc->arena, argxc->spec, (int)argxc->mainArgsCount, argxc->mainArgs,
+                    actions, endOfOptions);
+        }
+    }
+
+    ARGX_STATS_END(parseNs);
+    ARGX_TRACE_END(ARGX_TRACE_PARSE);
+
+    return argxc->result != NULL;
+}
+
+bool argxcReset(Argxc *argxc, int argc, char *argv[])
+{
+    if (!argxc || argc < 0 || (argc > 0 && !argv)) return false;
+
+    releaseArgs(argxc);
+
+    argxc->mainArgs = argv;
+    argxc->mainArgsCount = (size_t)argc;
+    argxc->mainArgc = (unsigned int)argc;
+    argxc->borrowedArgs = true;
+
+    // Parsed lazily, into the buffers of the previous parse
+    if (argxc->result) argxc->argsReset = true;
+
+    return true;
+}
+
+bool argxcParse(Argxc *argxc)
+{
+    return parseInstance(argxc, false);
+}
+
+bool argxcDispatch(Argxc *argxc)
+{
+    return parseInstance(argxc, true) && argxcResultGetStopPos(argxc->result) < 0;
+}
+
+ArgxcSpec *argxcCompile(Argxc *argxc)
+{
+    return argxc ? argxcSpecCreate(argxc->options, argxc->optionsCount, argxc->flags) : NULL;
+}
+
+const ArgxcSpec *argxcGetSpec(Argxc *argxc)
+{
+    return argxc && ensureParsed(argxc) ? argxc->spec : NULL;
+}
+
+const ArgxcResult *argxcGetResult(Argxc *argxc)
+{
+    return argxc && ensureParsed(argxc) ? argxc->result : NULL;
+}
+
+void argxcSetFlags(Argxc *argxc, unsigned int flags)
+{
+    if (!argxc || argxc->flags == flags) return;
+
+    argxc->flags = flags;
+    invalidateParse(argxc);
+}
+
+unsigned int argxcGetFlags(Argxc *argxc)
+{
+    return argxc ? argxc->flags : 0;
+}
+
+bool argxcGetStats(const Argxc *argxc, ArgxcStats *stats)
+{
+    if (!stats) return false;
+
+    memset(stats, 0, sizeof(*stats));
+
+#if ARGX_STATS
+    if (!argxc) return false;
+
+    *stats = argxc->stats;
+
+    return true;
+#else
+    (void)argxc;
+
+    return false;
+#endif
+}
+
+#if ARGX_STATS
+ArgxcStats *argxcStatsOf(Argxc *argxc)
+{
+    return argxc ? &argxc->stats : NULL;
+}
+#endif
+
+void argxcResetStats(Argxc *argxc)
+{
+#if ARGX_STATS
+    if (argxc) memset(&argxc->stats, 0, sizeof(argxc->stats));
+#else
+    (void)argxc;
+#endif
+}
+
+int argxcFindParam(Argxc *argxc, const char *id)
+{
+    if (!argxc || !id || !ensureParsed(argxc)) return -1;
+
+    ARGX_TRACE_BEGIN(ARGX_TRACE_FIND_PARAM);
+    ARGX_STATS_BEGIN(&argxc->stats);
+    int index = argxcResultFindParam(argxc->result, id);
+    ARGX_STATS_END(lookupNs);
+    ARGX_TRACE_END(ARGX_TRACE_FIND_PARAM);
+
+    return index;
+}
+
+bool argxcParamExists(Argxc *argxc, const char *id)
+{
+    return argxcFindParam(argxc, id) >= 0;
+}
+
+ArgxcParam argxcGetParam(Argxc *argxc, const char *id)
+{
+    ArgxcParam result = {false, 0, 0, NULL, (size_t)-1};
+
+    if (!argxc || !id || argxc->mainArgc <= 1 || !ensureParsed(argxc))
+	{
+        return result;
+    }
+
+    // The parse a first lookup may trigger is timed as a parse
+    ARGX_TRACE_BEGIN(ARGX_TRACE_GET_PARAM);
+    ARGX_STATS_BEGIN(&argxc->stats);
+    result = argxcResultGetParam(argxc->result, id);
+    ARGX_STATS_END(lookupNs);
+    ARGX_TRACE_END(ARGX_TRACE_GET_PARAM);
+
+    return result;
+}
+
+size_t argxcGetCommandPath(Argxc *argxc, const char **ids, size_t max)
+{
+    if (!argxc || !ensureParsed(argxc)) return 0;
+
+    size_t depth = argxcResultGetCommandDepth(argxc->result);
+
+    for (size_t d = 0; ids && d < depth && d < max; d++)
+	{
+        ids[d] = argxcResultGetCommandId(argxc->result, d);
+    }
+
+    return depth;
+}
+
+bool argxcGetSubParam(Argxc *argxc, const ArgxcParam *param, const char *id)
+{
+    if (!argxc || !param || !id || !ensureParsed(argxc)) return false;
+
+    ARGX_TRACE_BEGIN(ARGX_TRACE_GET_SUB_PARAM);
+    ARGX_STATS_BEGIN(&argxc->stats);
+    bool exists = argxcResultGetSubParam(argxc->result, param, id);
+    ARGX_STATS_END(lookupNs);
+    ARGX_TRACE_END(ARGX_TRACE_GET_SUB_PARAM);
+
+    return exists;
+}
+
+void argxcSetOptionValueType(ArgxcOptions *option, ArgxcValueType type)
+{
+    if (option) option->valueType = type;
+}
+
+void argxcSetOptionAction(ArgxcOptions *option, ArgxcAction action, void *userData)
+{
+    if (!option) return;
+
+    option->action = action;
+    option->actionData = userData;
+}
+
+ArgxcValueStatus argxcGetInt64(Argxc *argxc, const char *id, int64_t *value)
+{
+    return argxc && ensureParsed(argxc) ? argxcResultGetInt64(argxc->result, id, value) : ARGX_VALUE_UNSET;
+}
+
+ArgxcValueStatus argxcGetUint64(Argxc *argxc, const char *id, uint64_t *value)
+{
+    return argxc && ensureParsed(argxc) ? argxcResultGetUint64(argxc->result, id, value) : ARGX_VALUE_UNSET;
+}
+
+ArgxcValueStatus argxcGetDouble(Argxc *argxc, const char *id, double *value)
+{
+    return argxc && ensureParsed(argxc) ? argxcResultGetDouble(argxc->result, id, value) : ARGX_VALUE_UNSET;
+}
+
+ArgxcValueStatus argxcGetBool(Argxc *argxc, const char *id, bool *value)
+{
+    return argxc && ensureParsed(argxc) ? argxcResultGetBool(argxc->result, id, value) : ARGX_VALUE_UNSET;
+}
+
+ArgxcValueStatus argxcGetString(Argxc *argxc, const char *id, const char **value)
+{
+    return argxc && ensureParsed(argxc) ? argxcResultGetString(argxc->result, id, value) : ARGX_VALUE_UNSET;
+}
+
+ArgxcValueStatus argxcGetEnum(Argxc *argxc, const char *id, size_t *value)
+{
+    return argxc && ensureParsed(argxc) ? argxcResultGetEnum(argxc->result, id, value) : ARGX_VALUE_UNSET;
+}
+
+bool argxcParamHasSubAt(const ArgxcParam *param, size_t index)
+{
+    if (!param || index >= param->subExistsCount) return false;
+
+    if (index < 64) return (param->subExistsBits >> index) & 1;
+
+    return param->subExistsWide && ((param->subExistsWide[index / 64] >> (index % 64)) & 1);
+}
+
+static size_t optionStringLength(const ArgxcOptions *option, const char *str)
+{
+    if (!str) return 0;
+
+    return option->interned ? ARGX_INTERN_HEADER(str)->length : strlen(str);
+}
 
-    if (!argxc->mainArgs || !argxc->options)
-	{
-        argxcDestroy(argxc);
-        return NULL;
-    }
+// Whether `name` (a string of `option`) is the first `len` bytes of `arg`, hashed into
+// `hash`; interned names are told apart by length and hash before any byte is read
+static bool nameEquals(const ArgxcOptions *option, const char *name, const char *arg, size_t len, uint32_t hash)
+{
+    if (!name) return false;
 
-    for (int i = 0; i < argc; i++)
+    if (option->interned)
 	{
-        argxc->mainArgs[i] = stringDuplicate(argv[i]);
+        const ArgxcInternHeader *header = ARGX_INTERN_HEADER(name);
+        if (header->length != len || header->hash != hash) return false;
+
+        // Another handle of the same arena or option
+        if (name == arg) return true;
     }
 
-    return argxc;
+    ARGX_STATS_ADD(stringCompares, 1);
+
+    return strncmp(name, arg, len) == 0 && name[len] == '\0';
 }
 
-Argxc *argxcCreateDefault(void)
+// Resolve the first `len` bytes of an argument (hashed into `hash`) to the first option
+// naming them, through `index` when one is available
+static ArgxcOptions *findOptionByName(ArgxcOptions *options, size_t optionsCount, const ArgxcIndex *index,
+        const char *arg, size_t len, uint32_t hash)
 {
-    Argxc *argxc = malloc(sizeof(Argxc));
-    if (!argxc) return NULL;
+    if (index && index->capacity > 0)
+	{
+        size_t found = ARGX_INDEX_END;
+        const char *key = arg;
 
-    argxc->id = NULL;
-    argxc->mainArgs = NULL;
-    argxc->mainArgsCount = 0;
-    argxc->mainArgc = 0;
-    argxc->optionsCount = 0;
-    argxc->optionsCapacity = 10;
-    argxc->options = malloc(argxc->optionsCapacity * sizeof(ArgxcOptions));
+        // Once one entry matched, options of an arena sharing its name hold the same handle:
+        // the rest of the chain is compared by pointer
+        for (size_t pos = argxcIndexFind(index, ARGX_INDEX_NAME, key, len, hash);
+                pos != ARGX_INDEX_END; pos = argxcIndexNext(index, pos, ARGX_INDEX_NAME, key, len, hash))
+		{
+            key = index->entries[pos].key;
+            if (index->entries[pos].slot < found) found = index->entries[pos].slot;
+        }
 
-    if (!argxc->options)
+        return found != ARGX_INDEX_END && found < optionsCount ? &options[found] : NULL;
+    }
+
+    for (size_t j = 0; j < optionsCount; j++)
 	{
-        free(argxc); argxc = NULL;
-        return NULL;
+        if (nameEquals(&options[j], options[j].sparam, arg, len, hash) ||
+            	nameEquals(&options[j], options[j].param, arg, len, hash))
+		{
+            return &options[j];
+        }
     }
 
-    return argxc;
+    return NULL;
 }
 
-void argxcDestroy(Argxc *argxc)
+static ArgxcOptions *findSubOption(ArgxcOptions *parent, const char *arg)
 {
-    if (!argxc) return;
+    size_t len = 0;
+    uint32_t hash = argxcIndexHash(arg, &len);
 
-    free(argxc->id); argxc->id = NULL;
-    if (argxc->mainArgs) freeStringArray(argxc->mainArgs, argxc->mainArgsCount);
-    if (argxc->options) freeOptionsArray(argxc->options, argxc->optionsCount);
-    free(argxc); argxc = NULL;
+    return findOptionByName(parent->subParams, parent->subParamsCount, parent->subIndex, arg, len, hash);
 }
 
-// Core functionality implementations
-void argxcAddOption(Argxc *argxc, ArgxcOptions option)
+// A sub-option word, or `name=value` for a sub-option taking a value (`attached` receives the value)
+static ArgxcOptions *findSubOptionWord(ArgxcOptions *parent, const char *arg, const char **attached)
 {
-    if (!argxc) return;
+    *attached = NULL;
 
-    if (argxc->optionsCount >= argxc->optionsCapacity)
-	{
-        argxc->optionsCapacity *= 2;
-        argxc->options = realloc(argxc->options, argxc->optionsCapacity * sizeof(ArgxcOptions));
-        if (!argxc->options) return;
-    }
+    ArgxcOptions *subOption = findSubOption(parent, arg);
+    const char *equals = strchr(arg, '=');
 
-    argxc->options[argxc->optionsCount++] = option;
+    if (subOption || !equals || equals == arg) return subOption;
+
+    size_t len = (size_t)(equals - arg);
+
+    subOption = findOptionByName(parent->subParams, parent->subParamsCount, parent->subIndex, arg, len,
+            argxcIndexHashBytes(arg, len));
+    if (!subOption || subOption->valueType == ARGX_VALUE_NONE) return NULL;
+
+    *attached = equals + 1;
+
+    return subOption;
 }
 
-void argxcAddSubOption(ArgxcOptions *parent, ArgxcOptions subOption)
+// Map every single-character `-c` short option to the first option declaring it
+static void buildShortTable(ArgxcOptions *options, size_t optionsCount, ArgxcOptions **table)
 {
-    if (!parent) return;
+    memset(table, 0, 256 * sizeof(ArgxcOptions *));
 
-    if (parent->subParamsCount >= parent->subParamsCapacity)
+    for (size_t j = optionsCount; j-- > 0;)
 	{
-        size_t newCapacity = parent->subParamsCapacity == 0 ? 2 : parent->subParamsCapacity * 2;
-        ArgxcOptions *newSubParams = realloc(parent->subParams, newCapacity * sizeof(ArgxcOptions));
-        if (!newSubParams) return;
+        const char *sparam = options[j].sparam;
 
-        parent->subParams = newSubParams;
-        parent->subParamsCapacity = newCapacity;
+        if (sparam && sparam[0] == '-' && sparam[1] != '-' && sparam[1] != '\0' && sparam[2] == '\0')
+            table[(unsigned char)sparam[1]] = &options[j];
     }
-
-    parent->subParams[parent->subParamsCount++] = subOption;
 }
 
-int argxcFindParam(Argxc *argxc, const char *id)
+// Validate a POSIX cluster (`-abc`, `-j8`, `-sprofessional`): each character must be a short
+// option, and the first one taking a value or sub-parameters consumes the rest of the token.
+// `pending` receives an option ending the cluster that still expects its value or sub-parameter,
+// with the attached text (if any) of a typed option in `attached`.
+static bool compareShortCluster(ArgxcOptions **table, const char *arg, ArgxcOptions **pending, const char **attached)
 {
-    if (!argxc || !id) return -1;
+    *pending = NULL;
+    *attached = NULL;
 
-    // First check if it's a main parameter
-    for (size_t i = 0; i < argxc->optionsCount; i++)
-	{
-        if (argxc->options[i].id && strcmp(argxc->options[i].id, id) == 0)
-		{
-            // Check if this main parameter exists in arguments
-            for (size_t j = 0; j < argxc->mainArgsCount; j++)
-			{
-                if ((argxc->options[i].param && strcmp(argxc->mainArgs[j], argxc->options[i].param) == 0) ||
-                    	(argxc->options[i].sparam && strcmp(argxc->mainArgs[j], argxc->options[i].sparam) == 0))
-				{
-                    return (int)i;
-                }
-            }
-        }
-    }
+    if (arg[0] != '-' || arg[1] == '-' || arg[1] == '\0') return false;
 
-    // Then look for sub-parameters
-    for (size_t i = 0; i < argxc->optionsCount; i++)
+    for (const char *c = arg + 1; *c; c++)
 	{
-        ArgxcOptions *opt = &argxc->options[i];
+        ArgxcOptions *option = table[(unsigned char)*c];
+        if (!option) return false;
 
-        // Check if the parent option exists in the arguments
-        bool parentExists = false;
-        for (size_t j = 0; j < argxc->mainArgsCount; j++)
+        if (option->valueType != ARGX_VALUE_NONE && option->valueType != ARGX_VALUE_BOOL)
 		{
-            if ((opt->param && strcmp(argxc->mainArgs[j], opt->param) == 0) ||
-                	(opt->sparam && strcmp(argxc->mainArgs[j], opt->sparam) == 0))
-			{
-                parentExists = true;
-                break;
-            }
+            *pending = option;
+            if (c[1] != '\0') *attached = c + 1;
+
+            return true;
         }
 
-        if (parentExists)
+        if (option->hasSubParams || option->hasAnySubParams)
 		{
-            // Find the index of the requested sub-parameter
-            for (size_t j = 0; j < opt->subParamsCount; j++)
+            if (c[1] == '\0')
 			{
-                if (opt->subParams[j].id && strcmp(opt->subParams[j].id, id) == 0)
-				{
-                    return (int)j;
-                }
+                *pending = option;
+                return true;
             }
+
+            return findSubOption(option, c + 1) != NULL;
         }
     }
 
-    return -1; // Not found
+    return true;
 }
 
-bool argxcParamExists(Argxc *argxc, const char *id)
+// Check the value of a typed option, attached (`--opt=value`) or in the next argument
+static bool compareValue(ArgxcOptions *option, const char *attached, char **argv, size_t argvCount, size_t *i)
 {
-    return argxcFindParam(argxc, id) >= 0;
+    const char *text = attached;
+
+    if (!text)
+	{
+        if (option->valueType == ARGX_VALUE_BOOL) return true;
+
+        // Like a sub-parameter, a value missing at the very end is not reported here
+        if (*i + 1 >= argvCount) return true;
+
+        text = argv[++*i];
+        if (!text) return false;
+    }
+
+    int64_t int64Value;
+    uint64_t uint64Value;
+    double doubleValue;
+    bool boolValue;
+
+    switch (option->valueType)
+	{
+        case ARGX_VALUE_INT64: return argxcValueParseInt64(text, &int64Value);
+        case ARGX_VALUE_UINT64: return argxcValueParseUint64(text, &uint64Value);
+        case ARGX_VALUE_DOUBLE: return argxcValueParseDouble(text, &doubleValue);
+        case ARGX_VALUE_BOOL: return argxcValueParseBool(text, &boolValue);
+        case ARGX_VALUE_STRING: return true;
+        case ARGX_VALUE_ENUM: return findSubOption(option, text) != NULL;
+        default: return false;
+    }
 }
 
-ArgxcParam argxcGetParam(Argxc *argxc, const char *id)
+// First argument rejected by compareArgs()
+typedef struct {
+    ArgxcDiagnosticKind kind;
+    size_t position;
+    const char *token;
+    ArgxcOptions *parent;  // Option expecting the token, NULL for an unknown option
+} ArgxcCompareFailure;
+
+static bool rejectArg(ArgxcCompareFailure *failure, ArgxcDiagnosticKind kind, size_t position, const char *token,
+        ArgxcOptions *parent)
+{
+    failure->kind = kind;
+    failure->position = position;
+    failure->token = token;
+    failure->parent = parent;
+
+    return false;
+}
+
+// A value is the next argument, or the attached text when `*i` did not move
+static bool rejectValue(ArgxcCompareFailure *failure, ArgxcOptions *option, const char *attached, char **argv,
+        size_t start, size_t i)
+{
+    return rejectArg(failure, ARGX_DIAG_INVALID_VALUE, i, i == start && attached ? attached : argv[i], option);
+}
+
+// Lookup tables of compareArgs() over one option table
+typedef struct {
+    ArgxcIndex index;      // Names of the options, empty below ARGX_COMPARE_INDEX_THRESHOLD
+    ArgxcOptions *shortTable[256];
+    bool shortTableBuilt;  // Built on first use, or up front when threads share the tables
+    size_t longestName;    // Longer arguments are never looked up
+} ArgxcCompareTables;
+
+static void initCompareTables(ArgxcCompareTables *tables, ArgxcOptions *options, size_t optionsCount, bool shortTable)
 {
-    ArgxcParam result = {false, NULL, 0};
+    memset(&tables->index, 0, sizeof(tables->index));
+    tables->shortTableBuilt = shortTable;
+    tables->longestName = 0;
 
-    if (!argxc || !id || argxc->mainArgc <= 1)
+    for (size_t j = 0; j < optionsCount; j++)
 	{
-        return result;
+        size_t param = optionStringLength(&options[j], options[j].param);
+        size_t sparam = optionStringLength(&options[j], options[j].sparam);
+
+        if (param > tables->longestName) tables->longestName = param;
+        if (sparam > tables->longestName) tables->longestName = sparam;
     }
 
-    // First, check if this is a top-level option
-    for (size_t i = 0; i < argxc->optionsCount; i++)
-	{
-        ArgxcOptions *opt = &argxc->options[i];
+    if (shortTable) buildShortTable(options, optionsCount, tables->shortTable);
+
+    // Large option sets get an index so each argument is resolved in O(1)
+    if (optionsCount < ARGX_COMPARE_INDEX_THRESHOLD) return;
 
-        if (opt->id && strcmp(opt->id, id) == 0)
+    for (size_t j = 0; j < optionsCount; j++)
+	{
+        if (!indexString(&tables->index, ARGX_INDEX_NAME, &options[j], options[j].param, j) ||
+            	!indexString(&tables->index, ARGX_INDEX_NAME, &options[j], options[j].sparam, j))
 		{
-            // Find the position of the main option in arguments
-            int mainOptionPos = -1;
+            argxcIndexFree(&tables->index); // Fall back to the linear scan
+            return;
+        }
+    }
+}
 
-            for (size_t j = 0; j < argxc->mainArgsCount; j++)
-			{
-                if ((opt->param && strcmp(argxc->mainArgs[j], opt->param) == 0) ||
-                    	(opt->sparam && strcmp(argxc->mainArgs[j], opt->sparam) == 0))
-				{
-                    result.exists = true;
-                    mainOptionPos = j;
-                    break;
-                }
-            }
+static bool compareArgs(ArgxcOptions *options, size_t optionsCount, ArgxcCompareTables *tables, char **argv,
+        size_t argvCount, ArgxcCompareFailure *failure)
+{
+    ArgxcIndex *index = &tables->index;
+    bool valid = true;
 
-            if (result.exists)
-			{
-                if (opt->hasSubParams || opt->hasAnySubParams)
-				{
-                    // Allocate memory for sub-parameter existence array
-                    result.subExistsCount = opt->subParamsCount;
-                    result.subExists = malloc(result.subExistsCount * sizeof(bool));
+    for (size_t i = 1; i < argvCount && valid; i++)
+	{
+        const char *arg = argv[i];
+        const char *attached = NULL;
+        ArgxcOptions *matchedOption = NULL;
+        ArgxcTokenInfo info;
 
-                    if (result.subExists)
-					{
-                        // Check each sub-parameter
-                        for (size_t j = 0; j < opt->subParamsCount; j++)
-						{
-                            bool subMatched = false;
-                            ArgxcOptions *sub = &opt->subParams[j];
-
-                            // Look for sub-parameters after the main option
-                            for (size_t k = mainOptionPos + 1; k < argxc->mainArgsCount; k++)
-							{
-                                if ((sub->param && strcmp(argxc->mainArgs[k], sub->param) == 0) ||
-                                    	(sub->sparam && strcmp(argxc->mainArgs[k], sub->sparam) == 0))
-								{
-                                    subMatched = true;
-                                    break;
-                                }
-                            }
-
-                            result.subExists[j] = subMatched;
-                        }
-                    }
-                }
+        ARGX_STATS_ADD(tokensScanned, 1);
 
-                return result;
-            }
+        // One scan gives the length, the `=` and the hash; arguments longer than every name match none
+        if (arg) argxcClassifyToken(arg, tables->longestName, &info);
+        if (arg && info.hashed)
+		{
+            matchedOption = findOptionByName(options, optionsCount, index, arg, info.length, info.hash);
         }
-    }
 
-    // If not found as top-level, check if it's a sub-parameter
-    for (size_t i = 0; i < argxc->optionsCount; i++)
-	{
-        ArgxcOptions *opt = &argxc->options[i];
+        if (!matchedOption && arg && arg[0] == '-' && info.split < info.length && info.split != 1 &&
+            	info.split <= tables->longestName)
+		{
+            // `--name=value` is only accepted by options taking a value
+            matchedOption = findOptionByName(options, optionsCount, index, arg, info.split,
+                    argxcIndexHashBytes(arg, info.split));
 
-        // Find if the parent option exists and get its position
-        int parentPos = -1;
+            if (matchedOption && matchedOption->valueType != ARGX_VALUE_NONE) attached = arg + info.split + 1;
+            else matchedOption = NULL;
+        }
 
-        for (size_t j = 0; j < argxc->mainArgsCount; j++)
+        if (!matchedOption)
 		{
-            if ((opt->param && strcmp(argxc->mainArgs[j], opt->param) == 0) ||
-                	(opt->sparam && strcmp(argxc->mainArgs[j], opt->sparam) == 0))
+            // Not a full name: maybe a cluster of short options, built on first use
+            if (!tables->shortTableBuilt)
+			{
+                buildShortTable(options, optionsCount, tables->shortTable);
+                tables->shortTableBuilt = true;
+            }
+
+            if (!arg || !compareShortCluster(tables->shortTable, arg, &matchedOption, &attached))
 			{
-                parentPos = j;
+                valid = rejectArg(failure, ARGX_DIAG_UNKNOWN_OPTION, i, arg, NULL);
                 break;
             }
+
+            if (!matchedOption) continue;
+        }
+
+        if (matchedOption->valueType != ARGX_VALUE_NONE)
+		{
+            size_t start = i;
+
+            valid = compareValue(matchedOption, attached, argv, argvCount, &i) ||
+                rejectValue(failure, matchedOption, attached, argv, start, i);
+            continue;
         }
 
-        if (parentPos >= 0 && (opt->hasSubParams || opt->hasAnySubParams))
+        if (matchedOption->hasSubParams || matchedOption->hasAnySubParams)
 		{
-            // Check if the requested sub-parameter exists after the parent
-            for (size_t j = 0; j < opt->subParamsCount; j++)
+            // Check if there's a next argument
+            if (i + 1 < argvCount)
 			{
-                ArgxcOptions *sub = &opt->subParams[j];
+                const char *nextArg = argv[i + 1];
+                const char *subValue = NULL;
+                ArgxcOptions *subOption = NULL;
 
-                if (sub->id && strcmp(sub->id, id) == 0)
+                // Check if next argument is a valid sub-parameter
+                if (nextArg && nextArg[0] != '\0' && nextArg[0] != '-' &&
+                    	(subOption = findSubOptionWord(matchedOption, nextArg, &subValue)))
 				{
-                    for (size_t k = parentPos + 1; k < argxc->mainArgsCount; k++)
-					{
-                        if ((sub->param && strcmp(argxc->mainArgs[k], sub->param) == 0) ||
-                            	(sub->sparam && strcmp(argxc->mainArgs[k], sub->sparam) == 0))
-						{
-                            result.exists = true;
-                            break;
-                        }
-                    }
+                    i++; // Skip the sub-parameter
 
-                    if (!result.exists && (size_t)(parentPos + 1) < argxc->mainArgsCount)
+                    // ...and its own value, if it takes one
+                    if (subOption->valueType != ARGX_VALUE_NONE)
 					{
-                        char *nextArg = argxc->mainArgs[parentPos + 1];
-
-                        if ((sub->param && strcmp(nextArg, sub->param) == 0) ||
-                            	(sub->sparam && strcmp(nextArg, sub->sparam) == 0))
-						{
-                            result.exists = true;
-                        }
-                    }
+                        size_t start = i;
 
-                    // Handle any sub-sub-parameters if they exist
-                    if (result.exists && (sub->hasSubParams || sub->hasAnySubParams))
-					{
-                        result.subExistsCount = sub->subParamsCount;
-                        result.subExists = malloc(result.subExistsCount * sizeof(bool));
-
-                        if (result.subExists)
-						{
-                            for (size_t k = 0; k < sub->subParamsCount; k++)
-							{
-                                bool subsubMatched = false;
-                                ArgxcOptions *subsub = &sub->subParams[k];
-
-                                for (size_t l = 0; l < argxc->mainArgsCount; l++)
-								{
-                                    if ((subsub->param && strcmp(argxc->mainArgs[l], subsub->param) == 0) ||
-                                        	(subsub->sparam && strcmp(argxc->mainArgs[l], subsub->sparam) == 0))
-									{
-                                        subsubMatched = true;
-                                        break;
-                                    }
-                                }
-
-                                result.subExists[k] = subsubMatched;
-                            }
-                        }
+                        valid = compareValue(subOption, subValue, argv, argvCount, &i) ||
+                            rejectValue(failure, subOption, subValue, argv, start, i);
                     }
-
-                    return result;
+                }
+                else
+				{
+                    valid = rejectArg(failure, ARGX_DIAG_UNKNOWN_SUB_OPTION, i + 1, nextArg, matchedOption);
                 }
             }
         }
     }
 
-    return result;
+    return valid;
 }
 
-bool argxcGetSubParam(Argxc *argxc, const ArgxcParam *param, const char *id)
+bool argxcCompareArgs(ArgxcOptions *options, size_t optionsCount, char **argv, size_t argvCount)
 {
-    if (!argxc || !param || !id) return false;
+    if (!options || !argv) return false;
 
-    int index = argxcFindParam(argxc, id);
-    return argxcParamExists(argxc, id) && param->subExists && index >= 0 && 
-        (size_t)index < param->subExistsCount && param->subExists[index];
+    ArgxcCompareFailure failure;
+    ArgxcCompareTables tables;
+
+#if ARGX_STATS
+    // Counted apart, then added to the default instance of this thread if it still exists
+    ArgxcStats stats = {0};
+#endif
+
+    ARGX_TRACE_BEGIN(ARGX_TRACE_COMPARE_ARGS);
+    ARGX_STATS_BEGIN(&stats);
+    initCompareTables(&tables, options, optionsCount, false);
+    bool valid = compareArgs(options, optionsCount, &tables, argv, argvCount, &failure);
+    argxcIndexFree(&tables.index);
+    ARGX_STATS_END(parseNs);
+    ARGX_TRACE_END(ARGX_TRACE_COMPARE_ARGS);
+
+#if ARGX_STATS
+    argxcStatsMergeDefault(&stats);
+#endif
+
+    return valid;
 }
 
-char *argxcCreateDocs(Argxc *argxc, ArgxcStyle style, const char *title, const char *mainInfo)
+// Offer the names of `options` (one level) to a suggestion search
+static void offerNames(ArgxcSuggest *suggest, const ArgxcOptions *options, size_t optionsCount)
 {
-    if (!argxc) return NULL;
+    for (size_t j = 0; j < optionsCount; j++)
+	{
+        argxcSuggestOffer(suggest, options[j].param);
+        argxcSuggestOffer(suggest, options[j].sparam);
+    }
+}
 
-    size_t bufferSize = 4096;
-    char *contentStr = malloc(bufferSize);
-    if (!contentStr) return NULL;
+// Fill a diagnostic from the first argument compareArgs() rejected
+static void describeFailure(ArgxcOptions *options, size_t optionsCount, const ArgxcCompareFailure *failure,
+        ArgxcDiagnostic *diagnostic)
+{
+    diagnostic->kind = failure->kind;
+    diagnostic->position = (int)failure->position;
+    diagnostic->token = failure->token;
+    diagnostic->parent = failure->parent ? failure->parent->id : NULL;
 
-    contentStr[0] = '\0';
+    // Names the token could stand for: options, or the sub-options (enum values) of its parent
+    bool named = failure->kind != ARGX_DIAG_INVALID_VALUE || failure->parent->valueType == ARGX_VALUE_ENUM;
+    ArgxcSuggest suggest;
 
-    if (style == ARGX_STYLE_PROFESSIONAL)
+    if (named && failure->token && argxcSuggestInit(&suggest, failure->token, ARGX_SUGGEST_MAX))
 	{
-        for (size_t i = 0; i < argxc->optionsCount; i++)
-		{
-            ArgxcOptions *opt = &argxc->options[i];
+        if (failure->parent) offerNames(&suggest, failure->parent->subParams, failure->parent->subParamsCount);
+        else offerNames(&suggest, options, optionsCount);
 
-            // Main option header line
-            char temp[512];
-            snprintf(temp, sizeof(temp), "ID: %s\n", opt->id ? opt->id : "");
-            strcat(contentStr, temp);
+        diagnostic->suggestionsCount = argxcSuggestFinish(&suggest, diagnostic->suggestions);
+    }
+}
 
-            snprintf(temp, sizeof(temp), "[ %s | %s", 
-                    opt->sparam ? opt->sparam : "", 
-                    opt->param ? opt->param : "");
-            strcat(contentStr, temp);
+static void clearDiagnostic(ArgxcDiagnostic *diagnostic)
+{
+    memset(diagnostic, 0, sizeof(*diagnostic));
+    diagnostic->position = -1;
+}
 
-            if (opt->hasSubParams && opt->subParamsCount > 0)
-			{
-                strcat(contentStr, " [ ");
+bool argxcDiagnoseArgs(ArgxcOptions *options, size_t optionsCount, char **argv, size_t argvCount,
+        ArgxcDiagnostic *diagnostic)
+{
+    if (diagnostic) clearDiagnostic(diagnostic);
 
-                for (size_t j = 0; j < opt->subParamsCount; j++)
-				{
-                    strcat(contentStr, opt->subParams[j].param ? opt->subParams[j].param : "");
+    if (!options || !argv) return false;
 
-                    if (j < opt->subParamsCount - 1)
-					{
-                        strcat(contentStr, " | ");
-                    } else if (j <= opt->subParamsCount)
-					{
-                        strcat(contentStr, " ");
-                    }
-                }
+    ArgxcCompareFailure failure;
+    ArgxcCompareTables tables;
 
-                strcat(contentStr, "] ] ");
-            } else {
-                strcat(contentStr, " ] ");
-            }
+#if ARGX_STATS
+    ArgxcStats stats = {0};
+#endif
 
-            strcat(contentStr, opt->info ? opt->info : "");
-            strcat(contentStr, "\n");
+    ARGX_TRACE_BEGIN(ARGX_TRACE_COMPARE_ARGS);
+    ARGX_STATS_BEGIN(&stats);
+    initCompareTables(&tables, options, optionsCount, false);
+    bool valid = compareArgs(options, optionsCount, &tables, argv, argvCount, &failure);
+    argxcIndexFree(&tables.index);
+    ARGX_STATS_END(parseNs);
+    ARGX_TRACE_END(ARGX_TRACE_COMPARE_ARGS);
 
-            // Print all sub-options
-            if (opt->hasSubParams && opt->subParamsCount > 0)
-			{
-                for (size_t j = 0; j < opt->subParamsCount; j++)
-				{
-                    ArgxcOptions *sub = &opt->subParams[j];
+#if ARGX_STATS
+    argxcStatsMergeDefault(&stats);
+#endif
 
-                    // Create spacing for alignment
-                    size_t paramLen = opt->param ? strlen(opt->param) : 0;
-                    for (size_t k = 0; k < paramLen; k++)
-					{
-                        strcat(contentStr, " ");
-                    }
+    if (!valid && diagnostic) describeFailure(options, optionsCount, &failure, diagnostic);
 
-                    snprintf(temp, sizeof(temp), "  [ %s | %s ] %s\n",
-                            sub->sparam ? sub->sparam : "",
-                            sub->param ? sub->param : "",
-                            sub->info ? sub->info : "");
-                    strcat(contentStr, temp);
-                }
-            }
-        }
-    } else if (style == ARGX_STYLE_SIMPLE)
-	{
-        for (size_t i = 0; i < argxc->optionsCount; i++)
-		{
-            ArgxcOptions *opt = &argxc->options[i];
+    return valid;
+}
 
-            char temp[256];
-            snprintf(temp, sizeof(temp), "%s, %s - %s\n",
-                    opt->sparam ? opt->sparam : "",
-                    opt->param ? opt->param : "",
-                    opt->info ? opt->info : "");
-            strcat(contentStr, temp);
+// Shared by the workers of argxcDiagnoseBatch(); only `valid` is written
+typedef struct {
+    ArgxcOptions *options;
+    size_t optionsCount;
+    ArgxcCompareTables *tables;
+    char **const *argvs;
+    const size_t *argvCounts;
+    ArgxcDiagnostic *diagnostics;
+    uint64_t valid;
+} ArgxcBatch;
+
+static void diagnoseRange(void *context, size_t begin, size_t end)
+{
+    ArgxcBatch *batch = context;
+    uint64_t valid = 0;
 
-            if (opt->hasSubParams && opt->subParamsCount > 0)
-			{
-                for (size_t j = 0; j < opt->subParamsCount; j++)
-				{
-                    ArgxcOptions *sub = &opt->subParams[j];
+    ARGX_TRACE_BEGIN(ARGX_TRACE_DIAGNOSE_BATCH);
 
-                    snprintf(temp, sizeof(temp), "  %s, %s - %s\n",
-                            sub->sparam ? sub->sparam : "",
-                            sub->param ? sub->param : "",
-                            sub->info ? sub->info : "");
-                    strcat(contentStr, temp);
-                }
-            }
-        }
-    }
+    for (size_t k = begin; k < end; k++)
+	{
+        ArgxcDiagnostic *diagnostic = &batch->diagnostics[k];
+        ArgxcCompareFailure failure;
 
-    // Combine title, mainInfo, and content
-    size_t titleLen = title ? strlen(title) : 0;
-    size_t mainInfoLen = mainInfo ? strlen(mainInfo) : 0;
-    size_t contentLen = strlen(contentStr);
-    size_t totalLen = titleLen + mainInfoLen + contentLen + 10; // Extra space for newlines
+        clearDiagnostic(diagnostic);
 
-    char *result = malloc(totalLen);
-    if (!result)
-	{
-        free(contentStr); contentStr = NULL;
-        return NULL;
+        if (!batch->argvs[k])
+		{
+            // A missing vector is invalid, with no argument to blame
+            diagnostic->kind = ARGX_DIAG_UNKNOWN_OPTION;
+            continue;
+        }
+
+        if (compareArgs(batch->options, batch->optionsCount, batch->tables, batch->argvs[k], batch->argvCounts[k], &failure))
+		{
+            valid++;
+        }
+        else describeFailure(batch->options, batch->optionsCount, &failure, diagnostic);
     }
 
-    snprintf(result, totalLen, "%s\n%s\n%s",
-            title ? title : "",
-            mainInfo ? mainInfo : "",
-            contentStr);
+    ARGX_TRACE_END(ARGX_TRACE_DIAGNOSE_BATCH);
 
-    free(contentStr); contentStr = NULL;
-    return result;
+    ARGX_ATOMIC_FETCH_ADD(&batch->valid, valid);
 }
 
-bool argxcCompareArgs(ArgxcOptions *options, size_t optionsCount, char **argv, size_t argvCount)
+size_t argxcDiagnoseBatch(ArgxcOptions *options, size_t optionsCount, char **const *argvs, const size_t *argvCounts,
+        size_t count, size_t threads, ArgxcDiagnostic *diagnostics)
 {
-    if (!options || !argv) return false;
+    if (!options || !argvs || !argvCounts || !diagnostics) return 0;
 
-    for (size_t i = 1; i < argvCount; i++)
-	{
-        const char *arg = argv[i];
+    // Built once (the short table too) and only read by the workers
+    ArgxcCompareTables tables;
+    initCompareTables(&tables, options, optionsCount, true);
 
-        bool found = false;
-        bool hasSubParams = false;
-        bool hasAnySubParams = false;
-        ArgxcOptions *matchedOption = NULL;
+    ArgxcBatch batch = {options, optionsCount, &tables, argvs, argvCounts, diagnostics, 0};
 
-        // Find the matching option
-        for (size_t j = 0; j < optionsCount; j++)
-		{
-            if ((options[j].sparam && strcmp(options[j].sparam, arg) == 0) ||
-                	(options[j].param && strcmp(options[j].param, arg) == 0))
-			{
-                found = true;
-                hasSubParams = options[j].hasSubParams;
-                hasAnySubParams = options[j].hasAnySubParams;
-                matchedOption = &options[j];
-                break;
-            }
-        }
+#if ARGX_STATS
+    ArgxcStats stats = {0};
+#endif
 
-        if (!found) return false;
+    ARGX_STATS_BEGIN(&stats);
+    argxcPoolRun(count, threads, ARGX_BATCH_CHUNK, diagnoseRange, &batch);
+    ARGX_STATS_END(parseNs);
 
-        if (hasSubParams || hasAnySubParams)
-		{
-            // Check if there's a next argument
-            if (i + 1 < argvCount)
-			{
-                const char *nextArg = argv[i + 1];
+#if ARGX_STATS
+    argxcStatsMergeDefault(&stats);
+#endif
 
-                // Check if next argument is a sub-parameter
-                bool isSubParam = false;
+    argxcIndexFree(&tables.index);
 
-                if (nextArg && strlen(nextArg) > 0 && nextArg[0] != '-')
-				{
-                    // Validate if it's a valid sub-parameter
-                    for (size_t k = 0; k < matchedOption->subParamsCount; k++)
-					{
-                        if ((matchedOption->subParams[k].param && strcmp(matchedOption->subParams[k].param, nextArg) == 0) ||
-                            	(matchedOption->subParams[k].sparam && strcmp(matchedOption->subParams[k].sparam, nextArg) == 0))
-						{
-                            isSubParam = true;
-                            break;
-                        }
-                    }
+    return (size_t)batch.valid;
+}
 
-                    if (isSubParam)
-					{
-                        i++; // Skip the sub-parameter
-                    } else if (hasSubParams || hasAnySubParams)
-					{
-                        return false;
-                    }
-                } else if (hasSubParams || hasAnySubParams)
-				{
-                    return false;
-                }
-            }
-        }
-    }
+size_t argxcSuggest(const ArgxcOptions *options, size_t optionsCount, const char *token, const char **names,
+        size_t max)
+{
+    if ((!options && optionsCount > 0) || !token || !names) return 0;
 
-    return true;
+    ArgxcSuggest suggest;
+    if (!argxcSuggestInit(&suggest, token, max)) return 0;
+
+    offerNames(&suggest, options, optionsCount);
+
+    return argxcSuggestFinish(&suggest, names);
 }
 
 // Getters
@@ -585,6 +1387,13 @@ char **argxcGetMainArgs(Argxc *argxc, size_t *count)
     return copy;
 }
 
+const char *const *argxcGetMainArgsView(const Argxc *argxc, size_t *count)
+{
+    if (count) *count = argxc ? argxc->mainArgsCount : 0;
+
+    return argxc ? (const char *const *)argxc->mainArgs : NULL;
+}
+
 int argxcGetArgc(Argxc *argxc)
 {
     return argxc ? argxc->mainArgc : 0;
@@ -598,55 +1407,101 @@ ArgxcOptions *argxcGetOptions(Argxc *argxc, size_t *count)
     return argxc->options; // Return direct reference (be careful with modification)
 }
 
+ArgxcArena *argxcGetArena(Argxc *argxc)
+{
+    return argxc ? argxc->arena : NULL;
+}
+
 const char *argxcGetId(Argxc *argxc)
 {
     return argxc ? argxc->id : NULL;
 }
 
 // Utility functions for memory management
-ArgxcOptions argxcCreateOption(const char *id, const char *param, const char *sparam, 
+
+ArgxcOptions argxcCreateOptionIn(ArgxcArena *arena, const char *id, const char *param, const char *sparam, 
         const char *info, bool hasSubParams, bool hasAnySubParams)
 {
     ArgxcOptions option = {0};
 
-    option.id = stringDuplicate(id);
-    option.param = stringDuplicate(param);
-    option.sparam = stringDuplicate(sparam);
-    option.info = stringDuplicate(info);
+    // Equal strings share one handle: of the arena, or of the option's own block on the heap
+    if (arena)
+	{
+        option.id = argxcIntern(arena, id);
+        option.param = argxcIntern(arena, param);
+        option.sparam = argxcIntern(arena, sparam);
+        option.info = argxcIntern(arena, info);
+    }
+    else
+	{
+        const char *strs[4] = {id, param, sparam, info};
+        char *handles[4];
+
+        argxcInternBlock(strs, handles, 4);
+
+        option.id = handles[0];
+        option.param = handles[1];
+        option.sparam = handles[2];
+        option.info = handles[3];
+    }
     option.hasSubParams = hasSubParams;
     option.hasAnySubParams = hasAnySubParams;
     option.subParams = NULL;
     option.subParamsCount = 0;
+    option.subIndex = NULL;
+    option.arena = arena;
+    option.interned = true;
+    option.valueType = ARGX_VALUE_NONE;
+    option.action = NULL;
+    option.actionData = NULL;
 
     return option;
 }
 
+ArgxcOptions argxcCreateOption(const char *id, const char *param, const char *sparam, 
+        const char *info, bool hasSubParams, bool hasAnySubParams)
+{
+    return argxcCreateOptionIn(NULL, id, param, sparam, info, hasSubParams, hasAnySubParams);
+}
+
 void argxcFreeOption(ArgxcOptions *option)
 {
     if (!option) return;
 
-    if (option->id)
-	{ free(option->id); option->id = NULL; }
-    if (option->param)
-	{ free(option->param); option->param = NULL; }
-    if (option->sparam)
-	{ free(option->sparam); option->sparam = NULL; }
-    if (option->info)
-	{ free(option->info); option->info = NULL; }
+    ArgxcArena *arena = option->arena; // Arena memory is released with the arena
+    char **fields[4] = {&option->id, &option->param, &option->sparam, &option->info};
+    const char *strings = optionStrings(option);
+
+    // Handles of a heap option share one block; those of an arena belong to its table
+    if (option->interned && !arena && strings) argxcInternRelease(strings);
+
+    for (size_t i = 0; i < 4; i++)
+	{
+        if (!option->interned) argxcArenaFree(arena, *fields[i]);
+
+        *fields[i] = NULL;
+    }
 
     if (option->subParams)
 	{
+        // Children may come from the C heap even under an arena parent
         for (size_t i = 0; i < option->subParamsCount; i++)
 		{
             argxcFreeOption(&option->subParams[i]);
         }
 
-    	free(option->subParams); 
+    	argxcArenaFree(arena, option->subParams); 
 		option->subParams = NULL;
 		option->subParamsCapacity = 0;
 		option->subParamsCount = 0;
 	}
 
+    if (option->subIndex)
+	{
+        argxcIndexFree(option->subIndex);
+        argxcArenaFree(arena, option->subIndex); option->subIndex = NULL;
+    }
+
     memset(option, 0, sizeof(ArgxcOptions));
 }
 
@@ -654,7 +1509,7 @@ void argxcFreeParam(ArgxcParam *param)
 {
     if (!param) return;
 
-    free(param->subExists); param->subExists = NULL;
+    // Parameters own no memory; this only resets them
     memset(param, 0, sizeof(ArgxcParam));
 }
 
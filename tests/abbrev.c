@@ -0,0 +1,71 @@
+// tests/abbrev.c
+// Owned and created by: pcannon09
+//
+// Long-option abbreviations (ARGX_FLAG_ABBREV): unique prefixes resolve, exact names win,
+// and ambiguous prefixes are reported instead of picking an option.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "../inc/Argx.h"
+#include "../inc/ARGXSpec.h"
+#include "check.h"
+
+static void addOptions(Argxc *argxc)
+{
+    argxcAddOption(argxc, argxcCreateOption("verbose", "--verbose", "-V", "Talk more", false, false));
+    argxcAddOption(argxc, argxcCreateOption("version", "--version", "-v", "Show the version", false, false));
+    argxcAddOption(argxc, argxcCreateOption("versionInfo", "--version-info", NULL, "Show build details", false, false));
+    argxcAddOption(argxc, argxcCreateOption("help", "--help", "-h", "Show this help", false, false));
+}
+
+int main(void)
+{
+    char *argv[] = {"prog", "--verb", "--ver", "--help"};
+    Argxc *argxc = argxcCreate("abbrev", 4, argv);
+    CHECK(argxc != NULL);
+    if (!argxc) return checkResult();
+
+    addOptions(argxc);
+
+    const ArgxcSpec *spec = argxcGetSpec(argxc);
+    const char *name = NULL;
+
+    // Unique prefix, exact name that also prefixes another, ambiguous prefix, unknown
+    CHECK(argxcSpecResolveAbbrev(spec, "--verb", &name) == 1);
+    CHECK(name && strcmp(name, "--verbose") == 0);
+    CHECK(argxcSpecResolveAbbrev(spec, "--version", &name) == 1);
+    CHECK(name && strcmp(name, "--version") == 0);
+    CHECK(argxcSpecResolveAbbrev(spec, "--ver", NULL) == 3);
+    CHECK(argxcSpecResolveAbbrev(spec, "--versio", NULL) == 2);
+    CHECK(argxcSpecResolveAbbrev(spec, "--x", NULL) == 0);
+
+    // Completion lists the candidates of an ambiguous prefix in sorted order
+    const char *names[4] = {NULL};
+    CHECK(argxcSpecComplete(spec, "--ver", names, 4) == 3);
+    CHECK(names[0] && strcmp(names[0], "--verbose") == 0);
+    CHECK(names[1] && strcmp(names[1], "--version") == 0);
+    CHECK(names[2] && strcmp(names[2], "--version-info") == 0);
+
+    // Without the flag, prefixes are unknown arguments
+    CHECK(!argxcParamExists(argxc, "verbose"));
+    CHECK(argxcParamExists(argxc, "help"));
+
+    argxcSetFlags(argxc, ARGX_FLAG_ABBREV);
+
+    CHECK(argxcParamExists(argxc, "verbose"));
+    CHECK(!argxcParamExists(argxc, "version"));
+    CHECK(!argxcParamExists(argxc, "versionInfo"));
+    CHECK(argxcParamExists(argxc, "help"));
+
+    const ArgxcResult *result = argxcGetResult(argxc);
+    CHECK(argxcResultGetAmbiguousCount(result) == 1);
+    CHECK(argxcResultFindAmbiguous(result, 0) == 2);
+    CHECK(argxcResultFindAmbiguous(result, 3) == -1);
+
+    argxcDestroy(argxc);
+
+    return checkResult();
+}
@@ -0,0 +1,25 @@
+// tests/check.h
+// Owned and created by: pcannon09
+//
+// Assertions of the self-checking tests run by ctest: a failed check is reported and
+// counted, and the test exits with checkResult().
+
+#pragma once
+
+#include <stdio.h>
+
+static int checkFailures = 0;
+
+static void checkFail(const char *file, int line, const char *cond)
+{
+    fprintf(stderr, "%s:%d: check failed: %s\n", file, line, cond);
+    checkFailures++;
+}
+
+#define CHECK(cond) do { if (!(cond)) checkFail(__FILE__, __LINE__, #cond); } while (0)
+
+// Exit status of a test: 0 when every check passed
+#define checkResult() (checkFailures ? 1 : 0)
+
+// Exit status telling ctest the test was skipped (see SKIP_RETURN_CODE in CMakeLists.txt)
+#define CHECK_SKIPPED 77
@@ -0,0 +1,95 @@
+// tests/cluster.c
+// Owned and created by: pcannon09
+//
+// POSIX clusters of short options: `-abc` is `-a -b -c`, and the first option taking a
+// value or sub-parameters ends the cluster with the rest of the token as its value.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "../inc/Argx.h"
+#include "check.h"
+
+static Argxc *createParser(int argc, char *argv[])
+{
+    Argxc *argxc = argxcCreate("cluster", argc, argv);
+    if (!argxc) return NULL;
+
+    ArgxcOptions jobs = argxcCreateOption("jobs", "--jobs", "-j", "Parallel jobs", false, false);
+    ArgxcOptions output = argxcCreateOption("output", "--output", "-o", "Output file", false, false);
+    ArgxcOptions style = argxcCreateOption("style", "--style", "-s", "Documentation style", true, false);
+    ArgxcOptions again = argxcCreateOption("again", "--again", "-a", "Declared after `all`", false, false);
+
+    argxcSetOptionValueType(&jobs, ARGX_VALUE_INT64);
+    argxcSetOptionValueType(&output, ARGX_VALUE_STRING);
+    argxcSetOptionValueType(&again, ARGX_VALUE_STRING);
+
+    argxcAddSubOption(&style, argxcCreateOption("simple", "simple", "-b", "Simple style", false, false));
+    argxcAddSubOption(&style, argxcCreateOption("professional", "professional", "pro", "Professional style", false, false));
+
+    argxcAddOption(argxc, argxcCreateOption("all", "--all", "-a", "Everything", false, false));
+    argxcAddOption(argxc, argxcCreateOption("brief", "--brief", "-b", "Less output", false, false));
+    argxcAddOption(argxc, argxcCreateOption("color", "--color", "-c", "Colored output", false, false));
+    argxcAddOption(argxc, jobs);
+    argxcAddOption(argxc, output);
+    argxcAddOption(argxc, style);
+    argxcAddOption(argxc, again);
+
+    return argxc;
+}
+
+int main(void)
+{
+    // Booleans, then an attached value ending each cluster
+    char *argv[] = {"prog", "-abc", "-j8", "-boout.txt"};
+    Argxc *argxc = createParser(4, argv);
+    CHECK(argxc != NULL);
+    if (!argxc) return checkResult();
+
+    int64_t jobs = 0;
+    const char *output = NULL;
+
+    // `-a` belongs to its first declaration, a boolean: the typed `-a` declared later would
+    // have taken "bc" as its value
+    CHECK(argxcParamExists(argxc, "all"));
+    CHECK(argxcParamExists(argxc, "brief"));
+    CHECK(argxcParamExists(argxc, "color"));
+    CHECK(argxcGetInt64(argxc, "jobs", &jobs) == ARGX_VALUE_OK && jobs == 8);
+    CHECK(argxcGetString(argxc, "output", &output) == ARGX_VALUE_OK && output && strcmp(output, "out.txt") == 0);
+
+    // Sub-option names (here `-b` under `style`) never join the table of clusters
+    CHECK(!argxcParamExists(argxc, "simple"));
+    CHECK(!argxcParamExists(argxc, "style"));
+
+    size_t optionsCount = 0;
+    ArgxcOptions *options = argxcGetOptions(argxc, &optionsCount);
+
+    // An attached sub-parameter must be valid, like a separate one
+    char *valid[] = {"prog", "-ac", "-sprofessional", "-j", "4"};
+    char *badSub[] = {"prog", "-sbogus"};
+    char *badValue[] = {"prog", "-jx"};
+    char *unknown[] = {"prog", "-az"};
+
+    CHECK(argxcCompareArgs(options, optionsCount, valid, 5));
+    CHECK(!argxcCompareArgs(options, optionsCount, badSub, 2));
+    CHECK(!argxcCompareArgs(options, optionsCount, badValue, 2));
+    CHECK(!argxcCompareArgs(options, optionsCount, unknown, 2));
+
+    argxcDestroy(argxc);
+
+    // A token with an unknown character is not a cluster at all
+    char *partial[] = {"prog", "-az"};
+    argxc = createParser(2, partial);
+    CHECK(argxc != NULL);
+
+    if (argxc)
+	{
+        CHECK(!argxcParamExists(argxc, "all"));
+        argxcDestroy(argxc);
+    }
+
+    return checkResult();
+}
@@ -0,0 +1,126 @@
+// tests/commands.c
+// Owned and created by: pcannon09
+//
+// Sub-commands of any depth: words walk the option tree while parsing, and ids resolve
+// along the command path first.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "../inc/Argx.h"
+#include "../inc/ARGXSpec.h"
+#include "check.h"
+
+#define CHAIN_DEPTH 12
+
+// tool cluster node {drain --force, list}, plus a top-level `drain` without `--force`
+static Argxc *createTool(int argc, char *argv[])
+{
+    Argxc *argxc = argxcCreate("tool", argc, argv);
+    if (!argxc) return NULL;
+
+    ArgxcOptions cluster = argxcCreateOption("cluster", "cluster", NULL, "Manage the cluster", true, false);
+    ArgxcOptions node = argxcCreateOption("node", "node", NULL, "Manage nodes", true, false);
+    ArgxcOptions drain = argxcCreateOption("drain", "drain", NULL, "Drain a node", true, false);
+
+    argxcAddSubOption(&drain, argxcCreateOption("force", "--force", "-f", "Do not wait", false, false));
+    argxcAddSubOption(&node, drain);
+    argxcAddSubOption(&node, argxcCreateOption("list", "list", NULL, "List nodes", false, false));
+    argxcAddSubOption(&cluster, node);
+
+    argxcAddOption(argxc, cluster);
+    argxcAddOption(argxc, argxcCreateOption("drain", "drain", NULL, "Drain everything", false, false));
+
+    return argxc;
+}
+
+static void checkPath(int argc, char *argv[], const char *const *expected, size_t expectedDepth)
+{
+    Argxc *argxc = createTool(argc, argv);
+    CHECK(argxc != NULL);
+    if (!argxc) return;
+
+    const char *ids[8] = {NULL};
+    size_t depth = argxcGetCommandPath(argxc, ids, 8);
+
+    CHECK(depth == expectedDepth);
+
+    for (size_t i = 0; i < depth && i < expectedDepth; i++) CHECK(ids[i] && strcmp(ids[i], expected[i]) == 0);
+
+    argxcDestroy(argxc);
+}
+
+int main(void)
+{
+    char *argv[] = {"tool", "cluster", "node", "drain", "--force"};
+    Argxc *argxc = createTool(5, argv);
+    CHECK(argxc != NULL);
+    if (!argxc) return checkResult();
+
+    // `drain` resolves to the command on the path, which has `--force`
+    ArgxcParam param = argxcGetParam(argxc, "drain");
+    CHECK(param.exists);
+    CHECK(argxcGetSubParam(argxc, &param, "force"));
+    argxcFreeParam(&param);
+
+    const ArgxcResult *result = argxcGetResult(argxc);
+    CHECK(argxcResultGetCommandDepth(result) == 3);
+    CHECK(argxcResultGetCommandPos(result, 0) == 1);
+    CHECK(argxcResultGetCommandPos(result, 2) == 3);
+    CHECK(argxcResultGetCommandId(result, 1) && strcmp(argxcResultGetCommandId(result, 1), "node") == 0);
+    CHECK(argxcResultGetCommandAt(result, 3) == (size_t)-1);
+    CHECK(argxcResultGetCommandPos(result, 3) == -1);
+    CHECK(argxcResultGetCommandId(result, 3) == NULL);
+
+    argxcDestroy(argxc);
+
+    // Words naming no child are skipped; the top-level `drain` is only a command first
+    char *stray[] = {"tool", "cluster", "extra", "node", "list"};
+    const char *strayPath[] = {"cluster", "node", "list"};
+    checkPath(5, stray, strayPath, 3);
+
+    char *topLevel[] = {"tool", "drain", "node"};
+    const char *topLevelPath[] = {"drain"};
+    checkPath(3, topLevel, topLevelPath, 1);
+
+    // Operands after `--` are not commands
+    char *operands[] = {"tool", "cluster", "--", "node"};
+    const char *operandsPath[] = {"cluster"};
+    checkPath(4, operands, operandsPath, 1);
+
+    // A chain deeper than any fixed limit
+    static char names[CHAIN_DEPTH][8];
+    char *chainArgv[CHAIN_DEPTH + 1];
+    ArgxcOptions levels[CHAIN_DEPTH];
+
+    chainArgv[0] = "tool";
+
+    for (size_t i = 0; i < CHAIN_DEPTH; i++)
+	{
+        snprintf(names[i], sizeof(names[i]), "l%zu", i);
+        chainArgv[i + 1] = names[i];
+        levels[i] = argxcCreateOption(names[i], names[i], NULL, "Level", i + 1 < CHAIN_DEPTH, false);
+    }
+
+    for (size_t i = CHAIN_DEPTH - 1; i > 0; i--) argxcAddSubOption(&levels[i - 1], levels[i]);
+
+    argxc = argxcCreate("tool", CHAIN_DEPTH + 1, chainArgv);
+    CHECK(argxc != NULL);
+
+    if (argxc)
+	{
+        argxcAddOption(argxc, levels[0]);
+
+        const char *ids[CHAIN_DEPTH] = {NULL};
+        CHECK(argxcGetCommandPath(argxc, ids, CHAIN_DEPTH) == CHAIN_DEPTH);
+        CHECK(ids[CHAIN_DEPTH - 1] && strcmp(ids[CHAIN_DEPTH - 1], names[CHAIN_DEPTH - 1]) == 0);
+        CHECK(argxcParamExists(argxc, names[CHAIN_DEPTH - 1]));
+
+        argxcDestroy(argxc);
+    }
+    else argxcFreeOption(&levels[0]);
+
+    return checkResult();
+}
@@ -0,0 +1,121 @@
+// tests/image.c
+// Owned and created by: pcannon09
+//
+// Compiled spec images: a saved or copied image parses like the spec it came from, and
+// truncated or damaged images are rejected.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "../inc/Argx.h"
+#include "../inc/ARGXSpec.h"
+#include "check.h"
+
+static const char *const ids[] = {"help", "version", "message", "showVersion", "style", "simple", "professional", "jobs"};
+
+// Both specs must give the same answers for `argv`
+static void checkSameParse(const ArgxcSpec *expected, const ArgxcSpec *actual, int argc, char *argv[])
+{
+    ArgxcResult *a = argxcSpecParse(expected, argc, argv);
+    ArgxcResult *b = argxcSpecParse(actual, argc, argv);
+    CHECK(a != NULL && b != NULL);
+
+    for (size_t i = 0; a && b && i < sizeof(ids) / sizeof(ids[0]); i++)
+	{
+        CHECK(argxcResultParamExists(a, ids[i]) == argxcResultParamExists(b, ids[i]));
+        CHECK(argxcResultFindParam(a, ids[i]) == argxcResultFindParam(b, ids[i]));
+    }
+
+    int64_t jobsA = 0, jobsB = 0;
+    CHECK(argxcResultGetInt64(a, "jobs", &jobsA) == argxcResultGetInt64(b, "jobs", &jobsB));
+    CHECK(jobsA == 12 && jobsB == 12);
+
+    // `--sty` is an abbreviation, and `--version` comes after `--`
+    CHECK(argxcResultParamExists(b, "style") && argxcResultParamExists(b, "professional"));
+    CHECK(!argxcResultParamExists(b, "showVersion"));
+
+    argxcResultDestroy(a);
+    argxcResultDestroy(b);
+}
+
+int main(void)
+{
+    char *argv[] = {"prog", "--help", "message", "--sty", "pro", "-j", "12", "--", "--version"};
+    int argc = (int)(sizeof(argv) / sizeof(argv[0]));
+
+    Argxc *argxc = argxcCreate("image", argc, argv);
+    CHECK(argxc != NULL);
+    if (!argxc) return checkResult();
+
+    ArgxcOptions help = argxcCreateOption("help", "--help", "-h", "Show this help", true, false);
+    ArgxcOptions style = argxcCreateOption("style", "--style", "-s", "Documentation style", true, false);
+    ArgxcOptions jobs = argxcCreateOption("jobs", "--jobs", "-j", "Parallel jobs", false, false);
+
+    argxcAddSubOption(&help, argxcCreateOption("version", "version", "v", "Show version help", false, false));
+    argxcAddSubOption(&help, argxcCreateOption("message", "message", "m", "Show a message", false, false));
+    argxcAddSubOption(&style, argxcCreateOption("simple", "simple", "", "Simple style", false, false));
+    argxcAddSubOption(&style, argxcCreateOption("professional", "professional", "pro", "Professional style", false, false));
+    argxcSetOptionValueType(&jobs, ARGX_VALUE_INT64);
+
+    argxcAddOption(argxc, help);
+    argxcAddOption(argxc, argxcCreateOption("showVersion", "--version", "-v", "Show the version", false, false));
+    argxcAddOption(argxc, style);
+    argxcAddOption(argxc, jobs);
+    argxcSetFlags(argxc, ARGX_FLAG_ABBREV);
+
+    const ArgxcSpec *spec = argxcGetSpec(argxc);
+    CHECK(spec != NULL);
+
+    // Through a file
+    const char *path = "argxc_test_image.spec";
+    CHECK(argxcSpecSave(spec, path));
+
+    ArgxcSpec *loaded = argxcSpecLoad(path);
+    CHECK(loaded != NULL);
+
+    if (loaded)
+	{
+        const char *name = NULL;
+
+        CHECK(argxcSpecGetOptionsCount(loaded) == argxcSpecGetOptionsCount(spec));
+        CHECK(argxcSpecGetNodesCount(loaded) == argxcSpecGetNodesCount(spec));
+        CHECK(argxcSpecGetFlags(loaded) == ARGX_FLAG_ABBREV);
+        CHECK(argxcSpecResolveAbbrev(loaded, "--vers", &name) == 1 && name && strcmp(name, "--version") == 0);
+
+        checkSameParse(spec, loaded, argc, argv);
+        argxcSpecDestroy(loaded);
+    }
+
+    remove(path);
+    CHECK(argxcSpecLoad(path) == NULL);
+
+    // From memory: a copy works in place, a damaged or truncated one is rejected
+    size_t size = 0;
+    const void *image = argxcSpecGetImage(spec, &size);
+    uint64_t *copy = malloc(size + sizeof(uint64_t));
+    CHECK(image != NULL && size > 0 && copy != NULL);
+
+    if (image && copy)
+	{
+        memcpy(copy, image, size);
+
+        ArgxcSpec *inPlace = argxcSpecLoadImage(copy, size);
+        CHECK(inPlace != NULL);
+        if (inPlace) checkSameParse(spec, inPlace, argc, argv);
+        argxcSpecDestroy(inPlace);
+
+        CHECK(argxcSpecLoadImage(copy, size / 2) == NULL);
+        CHECK(argxcSpecLoadImage(copy, 4) == NULL);
+
+        ((unsigned char *)copy)[0] ^= 0xFF;
+        CHECK(argxcSpecLoadImage(copy, size) == NULL);
+    }
+
+    free(copy);
+    argxcDestroy(argxc);
+
+    return checkResult();
+}
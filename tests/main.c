@@ -13,8 +13,8 @@ int main(int argc, char *argv[])
 {
     char *docStr = NULL;
 
-    // Create Argxc instance
-    Argxc *mainArgxc = argxcCreate("main-args", argc, argv);
+    // Create Argxc instance (all of its memory comes from one arena)
+    Argxc *mainArgxc = argxcCreateWithArena("main-args", argc, argv);
 
     if (!mainArgxc)
 	{
@@ -22,24 +22,29 @@ int main(int argc, char *argv[])
         return 1;
     }
 
+    ArgxcArena *arena = argxcGetArena(mainArgxc);
+
     // Setup options
-    ArgxcOptions helpOption = argxcCreateOption(
+    ArgxcOptions helpOption = argxcCreateOptionIn(arena,
         	"help", "--help", "-h", "Show this help", true, false);
-    ArgxcOptions versionOption = argxcCreateOption(
+    ArgxcOptions versionOption = argxcCreateOptionIn(arena,
         	"version", "--version", "-v", "Show version message", false, false);
-    ArgxcOptions styleOption = argxcCreateOption(
+    ArgxcOptions styleOption = argxcCreateOptionIn(arena,
         	"style", "--style", "-s", "Set the style of the documentation (simple OR professional)", true, false);
 
     // Setup sub-options
-    ArgxcOptions versionSubOption = argxcCreateOption(
+    ArgxcOptions versionSubOption = argxcCreateOptionIn(arena,
         	"version", "version", "v", "Show version help", false, false);
-    ArgxcOptions messageSubOption = argxcCreateOption(
+    ArgxcOptions messageSubOption = argxcCreateOptionIn(arena,
         	"message", "message", "m", "Show a specific message", false, false);
 
-    ArgxcOptions styleSimpleSubOption = argxcCreateOption(
+    // The message text follows `message` (or `message=...`)
+    argxcSetOptionValueType(&messageSubOption, ARGX_VALUE_STRING);
+
+    ArgxcOptions styleSimpleSubOption = argxcCreateOptionIn(arena,
         	"simple", "simple", NULL, "Set simple documentation", false, false);
 
-    ArgxcOptions styleProfessionalSubOption = argxcCreateOption(
+    ArgxcOptions styleProfessionalSubOption = argxcCreateOptionIn(arena,
         	"professional", "professional", "pro", "Set professional documentation", false, false);
 
     // Add sub-options to styleOption
@@ -67,10 +72,7 @@ int main(int argc, char *argv[])
     {
         if (argxcGetArgc(mainArgxc) > 2)
         {
-			const char *secondArg = NULL;
-			size_t count = 0;
-
-            if (argc > 1) secondArg = argxcGetMainArgs(mainArgxc, &count)[2];
+			const char *secondArg = argxcGetMainArgsView(mainArgxc, NULL)[2];
 
             if (strcmp(secondArg, "simple") == 0)
                 docStr = argxcCreateDocs(mainArgxc, ARGX_STYLE_SIMPLE, "-- Docs ----", msg);
@@ -117,8 +119,10 @@ int main(int argc, char *argv[])
             printf("For more information, call the following parameter: `--version`\n");
         else if (argxcGetSubParam(mainArgxc, &helpParam, "message"))
         {
-            if (argxcGetArgc(mainArgxc) > 3)
-                printf("%s\n", argxcGetMainArgs(mainArgxc, NULL)[3]);
+            const char *message = NULL;
+
+            if (argxcGetString(mainArgxc, "message", &message) == ARGX_VALUE_OK)
+                printf("%s\n", message);
             else
                 printf("Enter a message in the third parameter as a string\n");
         }
@@ -143,12 +147,23 @@ int main(int argc, char *argv[])
     // Validate args
     size_t optionsCount = 0;
     ArgxcOptions *options = argxcGetOptions(mainArgxc, &optionsCount);
-    size_t argvCount = 0;
-    char **mainArgs = argxcGetMainArgs(mainArgxc, &argvCount);
+    ArgxcDiagnostic diagnostic;
 
-    if (!argxcCompareArgs(options, optionsCount, mainArgs, argvCount))
+    // Same arguments the instance was created from
+    if (!argxcDiagnoseArgs(options, optionsCount, argv, (size_t)argc, &diagnostic))
     {
-        printf("Argxc: Unknown option `%s`\n", argvCount > 1 ? mainArgs[1] : "<UNKNOWN>");
+        const char *token = diagnostic.token ? diagnostic.token : "<UNKNOWN>";
+
+        if (diagnostic.kind == ARGX_DIAG_INVALID_VALUE)
+            printf("Argxc: Invalid value `%s` for `%s` (argument %d)\n", token, diagnostic.parent, diagnostic.position);
+        else if (diagnostic.kind == ARGX_DIAG_UNKNOWN_SUB_OPTION)
+            printf("Argxc: Unknown sub-option `%s` for `%s` (argument %d)\n", token, diagnostic.parent, diagnostic.position);
+        else
+            printf("Argxc: Unknown option `%s` (argument %d)\n", token, diagnostic.position);
+
+        for (size_t i = 0; i < diagnostic.suggestionsCount; i++)
+            printf("%s `%s`\n", i == 0 ? "Did you mean" : "          or", diagnostic.suggestions[i]);
+
         if (docStr) free(docStr);
         argxcDestroy(mainArgxc);
         return 1;
@@ -0,0 +1,88 @@
+// tests/options.c
+// Owned and created by: pcannon09
+//
+// Ownership of options: one added under several holders is freed exactly once by each,
+// and interned strings are shared only where they are documented to be.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "../inc/Argx.h"
+#include "../inc/ARGXArena.h"
+#include "check.h"
+
+int main(void)
+{
+    // A heap option copies its strings; equal fields share one copy
+    char text[] = "fast";
+    ArgxcOptions fast = argxcCreateOption(text, text, NULL, "Fast mode", false, false);
+
+    text[0] = 'l';
+    CHECK(fast.id && strcmp(fast.id, "fast") == 0);
+    CHECK(fast.id == fast.param);
+    CHECK(fast.sparam == NULL);
+    argxcFreeOption(&fast);
+    CHECK(fast.id == NULL && fast.info == NULL);
+
+    // Options of one arena share each distinct string
+    ArgxcArena *arena = argxcArenaCreate(0);
+    CHECK(arena != NULL);
+
+    ArgxcOptions first = argxcCreateOptionIn(arena, "fast", "--fast", "-f", "Fast mode", false, false);
+    ArgxcOptions second = argxcCreateOptionIn(arena, "fast", "fast", "f", "Fast mode", false, false);
+
+    CHECK(first.id == second.id && first.id == second.param && first.info == second.info);
+    CHECK(first.param != second.param);
+    argxcArenaDestroy(arena);
+
+    // One sub-command (with children) and one leaf under two parents, each added twice
+    char *argv[] = {"prog", "build", "deploy", "target", "verbose", "--quiet"};
+    Argxc *argxc = argxcCreate("options", 6, argv);
+    CHECK(argxc != NULL);
+    if (!argxc) return checkResult();
+
+    ArgxcOptions build = argxcCreateOption("build", "build", NULL, "Build", true, false);
+    ArgxcOptions test = argxcCreateOption("test", "test", NULL, "Test", true, false);
+    ArgxcOptions deploy = argxcCreateOption("deploy", "deploy", NULL, "Deploy", true, false);
+    ArgxcOptions verbose = argxcCreateOption("verbose", "verbose", "v", "Talk more", false, false);
+    ArgxcOptions quiet = argxcCreateOption("quiet", "--quiet", "-q", "Talk less", false, false);
+
+    argxcAddSubOption(&deploy, argxcCreateOption("target", "target", NULL, "Deploy target", false, false));
+
+    argxcAddSubOption(&build, deploy);
+    argxcAddSubOption(&test, deploy);
+    argxcAddSubOption(&test, deploy);
+    argxcAddSubOption(&build, verbose);
+    argxcAddSubOption(&test, verbose);
+
+    argxcAddOption(argxc, build);
+    argxcAddOption(argxc, test);
+    argxcAddOption(argxc, quiet);
+    argxcAddOption(argxc, quiet);
+
+    size_t count = 0;
+    ArgxcOptions *options = argxcGetOptions(argxc, &count);
+
+    CHECK(count == 4);
+    CHECK(count == 4 && options[1].subParamsCount == 3);
+
+    // Every copy is still usable after the others were adopted
+    const char *path[4] = {NULL};
+    CHECK(argxcGetCommandPath(argxc, path, 4) == 3);
+    CHECK(path[2] && strcmp(path[2], "target") == 0);
+    CHECK(argxcParamExists(argxc, "verbose"));
+    CHECK(argxcParamExists(argxc, "quiet"));
+    CHECK(!argxcParamExists(argxc, "test"));
+
+    // Each holder frees its copy once: a double free aborts here
+    argxcDestroy(argxc);
+
+    // An option that was never added is freed by its creator
+    ArgxcOptions lone = argxcCreateOption("lone", "--lone", "-l", "Never added", true, false);
+    argxcAddSubOption(&lone, argxcCreateOption("child", "child", NULL, "Child", false, false));
+    argxcFreeOption(&lone);
+
+    return checkResult();
+}
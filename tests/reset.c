@@ -0,0 +1,125 @@
+// tests/reset.c
+// Owned and created by: pcannon09
+//
+// A reused instance parses each new command line into the memory of the previous ones:
+// once a line at least as long was parsed, argxcReset() and the next parse allocate nothing.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "../inc/Argx.h"
+#include "../inc/ARGXSpec.h"
+#include "check.h"
+
+#define OPTIONS_COUNT 64
+#define TOKENS_COUNT 256
+
+#ifdef ARGX_TEST_COUNT_ALLOCS
+// Fed by the linker-wrapped allocator (see CMakeLists.txt)
+static size_t allocCount = 0;
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size)
+{
+    allocCount++;
+    return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size)
+{
+    allocCount++;
+    return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    allocCount++;
+    return __real_realloc(ptr, size);
+}
+#endif
+
+int main(void)
+{
+#ifndef ARGX_TEST_COUNT_ALLOCS
+    printf("reset: allocations cannot be counted with this toolchain\n");
+    return CHECK_SKIPPED;
+#else
+    static char names[OPTIONS_COUNT][16];
+    static char subNames[OPTIONS_COUNT][16];
+    char *argv[TOKENS_COUNT];
+
+    argv[0] = "prog";
+
+    for (size_t t = 1; t < TOKENS_COUNT; t++)
+	{
+        size_t opt = (t * 7) % OPTIONS_COUNT;
+
+        snprintf(names[opt], sizeof(names[opt]), "--opt%zu", opt);
+        snprintf(subNames[opt], sizeof(subNames[opt]), "sub%zu", opt);
+        argv[t] = t % 3 ? names[opt] : subNames[opt];
+    }
+
+    Argxc *argxc = argxcCreateBorrowed("reset", TOKENS_COUNT, argv);
+    CHECK(argxc != NULL);
+    if (!argxc) return checkResult();
+
+    for (size_t i = 0; i < OPTIONS_COUNT; i++)
+	{
+        char id[16], name[16], sub[16];
+
+        snprintf(id, sizeof(id), "opt%zu", i);
+        snprintf(name, sizeof(name), "--opt%zu", i);
+        snprintf(sub, sizeof(sub), "sub%zu", i);
+
+        ArgxcOptions option = argxcCreateOption(id, name, NULL, "Option", true, false);
+        argxcAddSubOption(&option, argxcCreateOption(sub, sub, NULL, "Sub-option", false, false));
+        argxcAddOption(argxc, option);
+    }
+
+    // The first parse sizes the result for the longest line
+    CHECK(argxcParse(argxc));
+    CHECK(argxcParamExists(argxc, "opt0"));
+
+    size_t before = allocCount;
+
+    for (size_t r = 0; r < 100; r++)
+	{
+        int count = r % 2 ? TOKENS_COUNT : (int)(r % TOKENS_COUNT) + 1;
+
+        CHECK(argxcReset(argxc, count, argv));
+        CHECK(argxcParse(argxc));
+
+        ArgxcParam param = argxcGetParam(argxc, "opt7");
+        CHECK(param.exists == (count > 1));
+        argxcFreeParam(&param);
+    }
+
+    CHECK(allocCount == before);
+
+    // The same through a bare result
+    ArgxcSpec *spec = argxcCompile(argxc);
+    ArgxcResult *result = argxcSpecParse(spec, TOKENS_COUNT, argv);
+    CHECK(result != NULL);
+
+    before = allocCount;
+
+    for (size_t r = 0; r < 100 && result; r++)
+	{
+        ArgxcResult *again = argxcResultReparse(result, (int)(r % TOKENS_COUNT) + 1, argv, NULL);
+        CHECK(again == result);
+    }
+
+    CHECK(allocCount == before);
+
+    argxcResultDestroy(result);
+    argxcSpecDestroy(spec);
+    argxcDestroy(argxc);
+
+    return checkResult();
+#endif
+}
@@ -0,0 +1,110 @@
+// tests/response.c
+// Owned and created by: pcannon09
+//
+// `@file` expansion of argxcCreateWithResponseFiles(): quoting, NUL-separated files,
+// nesting and its depth limit.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "../inc/Argx.h"
+#include "check.h"
+
+static void writeFile(const char *path, const char *data, size_t size)
+{
+    FILE *file = fopen(path, "wb");
+    CHECK(file != NULL);
+    if (!file) return;
+
+    CHECK(fwrite(data, 1, size, file) == size);
+    fclose(file);
+}
+
+// Expand `args` (after argv[0]) and compare the result with `expected` (NULL-terminated);
+// `expected` NULL means the expansion must fail
+static void checkExpansion(char **args, int argc, int maxDepth, const char *const *expected)
+{
+    Argxc *argxc = argxcCreateWithResponseFiles("response", argc, args, maxDepth);
+
+    if (!expected)
+	{
+        CHECK(argxc == NULL);
+        argxcDestroy(argxc);
+        return;
+    }
+
+    CHECK(argxc != NULL);
+    if (!argxc) return;
+
+    size_t count = 0;
+    const char *const *view = argxcGetMainArgsView(argxc, &count);
+    size_t expectedCount = 0;
+
+    while (expected[expectedCount]) expectedCount++;
+
+    CHECK(count == expectedCount);
+
+    for (size_t i = 0; i < count && i < expectedCount; i++)
+	{
+        if (strcmp(view[i], expected[i]) != 0)
+		{
+            fprintf(stderr, "argument %zu: `%s`, expected `%s`\n", i, view[i], expected[i]);
+            CHECK(strcmp(view[i], expected[i]) == 0);
+        }
+    }
+
+    argxcDestroy(argxc);
+}
+
+int main(void)
+{
+    const char quoted[] = "--alpha \"two words\" 'single $quoted' esc\\ aped\n"
+        "\"say \\\"hi\\\"\" @inner.rsp\n";
+    const char inner[] = "--beta\t\t--gamma=1\n";
+    const char nul[] = "first arg\0second\0";
+
+    writeFile("outer.rsp", quoted, sizeof(quoted) - 1);
+    writeFile("inner.rsp", inner, sizeof(inner) - 1);
+    writeFile("nul.rsp", nul, sizeof(nul) - 1);
+    writeFile("empty.rsp", "", 0);
+    writeFile("self.rsp", "--again @self.rsp", 17);
+
+    // Quoting, escapes and one nested file
+    char *nested[] = {"prog", "@outer.rsp", "--tail"};
+    const char *nestedExpected[] = {"prog", "--alpha", "two words", "single $quoted", "esc aped",
+        "say \"hi\"", "--beta", "--gamma=1", "--tail", NULL};
+    checkExpansion(nested, 3, 0, nestedExpected);
+
+    // NUL bytes separate arguments and keep the blanks inside them
+    char *nulArgs[] = {"prog", "@nul.rsp"};
+    const char *nulExpected[] = {"prog", "first arg", "second", NULL};
+    checkExpansion(nulArgs, 2, 0, nulExpected);
+
+    // An empty file expands to nothing; a missing one stays a literal argument
+    char *emptyArgs[] = {"prog", "@empty.rsp", "@missing.rsp"};
+    const char *emptyExpected[] = {"prog", "@missing.rsp", NULL};
+    checkExpansion(emptyArgs, 3, 0, emptyExpected);
+
+    // argv[0] is never expanded
+    char *firstArgs[] = {"@outer.rsp"};
+    const char *firstExpected[] = {"@outer.rsp", NULL};
+    checkExpansion(firstArgs, 1, 0, firstExpected);
+
+    // Two levels of files fit a depth of 2, not of 1
+    checkExpansion(nested, 3, 2, nestedExpected);
+    checkExpansion(nested, 3, 1, NULL);
+
+    // A file including itself stops at the depth limit instead of recursing forever
+    char *selfArgs[] = {"prog", "@self.rsp"};
+    checkExpansion(selfArgs, 2, 0, NULL);
+
+    remove("outer.rsp");
+    remove("inner.rsp");
+    remove("nul.rsp");
+    remove("empty.rsp");
+    remove("self.rsp");
+
+    return checkResult();
+}
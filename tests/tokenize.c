@@ -0,0 +1,138 @@
+// tests/tokenize.c
+// Owned and created by: pcannon09
+//
+// Shell-style command strings: quoting, escapes, comments, the statuses of unfinished
+// lines, and argxcCreateFromString().
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "../inc/Argx.h"
+#include "../inc/ARGXTokenize.h"
+#include "check.h"
+
+// Tokenize `len` bytes of `line` and compare with `expected` (NULL-terminated)
+static void checkTokens(ArgxcTokens *tokens, const char *line, size_t len, const char *const *expected)
+{
+    CHECK(argxcTokenize(tokens, line, len) == ARGX_TOKENIZE_OK);
+
+    int count = 0;
+    while (expected[count]) count++;
+
+    if (tokens->argc != count) fprintf(stderr, "`%s`: %d arguments, expected %d\n", line, tokens->argc, count);
+
+    CHECK(tokens->argc == count);
+    CHECK(tokens->argv && tokens->argv[tokens->argc] == NULL);
+
+    for (int i = 0; i < tokens->argc && i < count; i++)
+	{
+        if (strcmp(tokens->argv[i], expected[i]) != 0)
+		{
+            fprintf(stderr, "`%s`: argument %d is `%s`, expected `%s`\n", line, i, tokens->argv[i], expected[i]);
+            CHECK(strcmp(tokens->argv[i], expected[i]) == 0);
+        }
+    }
+}
+
+static void checkLine(ArgxcTokens *tokens, const char *line, const char *const *expected)
+{
+    checkTokens(tokens, line, strlen(line), expected);
+}
+
+static void checkIncomplete(ArgxcTokens *tokens, const char *line)
+{
+    CHECK(argxcTokenize(tokens, line, strlen(line)) == ARGX_TOKENIZE_INCOMPLETE);
+    CHECK(tokens->argc == 0);
+    CHECK(tokens->endOfOptions == -1);
+}
+
+int main(void)
+{
+    ArgxcTokens tokens = {0};
+
+    // Quoting: '...' is literal, "..." escapes only $ ` " \ and newline
+    const char *quotes[] = {"a", "b c", "d \"e\" $f \\x", "g h", "$HOME", "*.c", NULL};
+    checkLine(&tokens, "a 'b c' \"d \\\"e\\\" \\$f \\x\" g\\ h $HOME *.c", quotes);
+
+    const char *single[] = {"it's", "a\\b", NULL};
+    checkLine(&tokens, "'it'\\''s' 'a\\b'", single);
+
+    // Empty quotes are arguments; adjacent parts join
+    const char *empty[] = {"", "", "ab", "x=1 2", NULL};
+    checkLine(&tokens, "'' \"\" a''b x='1 2'", empty);
+
+    // A comment starts an argument and ends with its line; `\` + newline continues a line
+    const char *comment[] = {"a", "b#c", "next", NULL};
+    checkLine(&tokens, "a b#c # 'not' \"an\" argument\nnext", comment);
+
+    const char *continued[] = {"abcd", "e", NULL};
+    checkLine(&tokens, "ab\\\ncd\te", continued);
+
+    const char *none[] = {NULL};
+    checkLine(&tokens, "  \t\n ", none);
+    checkLine(&tokens, "", none);
+
+    // NUL bytes separate arguments
+    const char *nul[] = {"a", "b", "c", NULL};
+    checkTokens(&tokens, "a\0b c", 5, nul);
+
+    // Only an unquoted `--` ends the options
+    const char *dashes[] = {"x", "--", "y", NULL};
+    checkLine(&tokens, "x -- y", dashes);
+    CHECK(tokens.endOfOptions == 1);
+    checkLine(&tokens, "x '--' y", dashes);
+    CHECK(tokens.endOfOptions == -1);
+
+    // Unfinished lines leave the tokens empty but reusable
+    checkIncomplete(&tokens, "a 'b c");
+    checkIncomplete(&tokens, "a \"b c");
+    checkIncomplete(&tokens, "a \"b \\");
+    checkIncomplete(&tokens, "a b\\");
+
+    // A shorter line reuses the buffers of a longer one
+    const char *longer[] = {"one", "two", "three", "four", NULL};
+    checkLine(&tokens, "one two three four", longer);
+
+    char *buffer = tokens.buffer;
+    char **argv = tokens.argv;
+
+    const char *shorter[] = {"five", NULL};
+    checkLine(&tokens, "five", shorter);
+    CHECK(tokens.buffer == buffer && tokens.argv == argv);
+
+    argxcTokensFree(&tokens);
+    CHECK(tokens.argv == NULL && tokens.buffer == NULL && tokens.argc == 0);
+
+    // From a command string: the id is argv[0] and a quoted `--` is an ordinary argument
+    Argxc *argxc = argxcCreateFromString("prog", "'--' --help \"two words\"");
+    CHECK(argxc != NULL);
+
+    if (argxc)
+	{
+        argxcAddOption(argxc, argxcCreateOption("help", "--help", "-h", "Show this help", false, false));
+
+        size_t count = 0;
+        const char *const *view = argxcGetMainArgsView(argxc, &count);
+
+        CHECK(count == 4);
+        CHECK(count == 4 && strcmp(view[0], "prog") == 0 && strcmp(view[1], "--") == 0 && strcmp(view[3], "two words") == 0);
+        CHECK(argxcParamExists(argxc, "help"));
+        argxcDestroy(argxc);
+    }
+
+    argxc = argxcCreateFromString("prog", "-- --help");
+    CHECK(argxc != NULL);
+
+    if (argxc)
+	{
+        argxcAddOption(argxc, argxcCreateOption("help", "--help", "-h", "Show this help", false, false));
+        CHECK(!argxcParamExists(argxc, "help"));
+        argxcDestroy(argxc);
+    }
+
+    CHECK(argxcCreateFromString("prog", "--help 'unfinished") == NULL);
+
+    return checkResult();
+}
@@ -0,0 +1,170 @@
+// tests/values.c
+// Owned and created by: pcannon09
+//
+// Typed option values: conversions, range and syntax errors, and the status of options
+// given without a value, not given, or read with the wrong type.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <float.h>
+#include <math.h>
+
+#include "../inc/Argx.h"
+#include "check.h"
+
+static void addTyped(Argxc *argxc, const char *id, const char *param, ArgxcValueType type)
+{
+    ArgxcOptions option = argxcCreateOption(id, param, NULL, "Typed option", type == ARGX_VALUE_ENUM, false);
+
+    if (type == ARGX_VALUE_ENUM)
+	{
+        argxcAddSubOption(&option, argxcCreateOption("fast", "fast", NULL, "Fast mode", false, false));
+        argxcAddSubOption(&option, argxcCreateOption("slow", "slow", NULL, "Slow mode", false, false));
+    }
+
+    argxcSetOptionValueType(&option, type);
+    argxcAddOption(argxc, option);
+}
+
+// Parser of `line` (after the program name) with one option of every type
+static Argxc *createParser(const char *line)
+{
+    Argxc *argxc = argxcCreateFromString("prog", line);
+    CHECK(argxc != NULL);
+    if (!argxc) return NULL;
+
+    addTyped(argxc, "count", "--count", ARGX_VALUE_INT64);
+    addTyped(argxc, "size", "--size", ARGX_VALUE_UINT64);
+    addTyped(argxc, "ratio", "--ratio", ARGX_VALUE_DOUBLE);
+    addTyped(argxc, "fast", "--fast", ARGX_VALUE_BOOL);
+    addTyped(argxc, "name", "--name", ARGX_VALUE_STRING);
+    addTyped(argxc, "mode", "--mode", ARGX_VALUE_ENUM);
+
+    return argxc;
+}
+
+static ArgxcValueStatus int64Of(const char *line, int64_t *value)
+{
+    Argxc *argxc = createParser(line);
+    ArgxcValueStatus status = argxc ? argxcGetInt64(argxc, "count", value) : ARGX_VALUE_UNSET;
+
+    argxcDestroy(argxc);
+    return status;
+}
+
+static ArgxcValueStatus uint64Of(const char *line, uint64_t *value)
+{
+    Argxc *argxc = createParser(line);
+    ArgxcValueStatus status = argxc ? argxcGetUint64(argxc, "size", value) : ARGX_VALUE_UNSET;
+
+    argxcDestroy(argxc);
+    return status;
+}
+
+static ArgxcValueStatus doubleOf(const char *line, double *value)
+{
+    Argxc *argxc = createParser(line);
+    ArgxcValueStatus status = argxc ? argxcGetDouble(argxc, "ratio", value) : ARGX_VALUE_UNSET;
+
+    argxcDestroy(argxc);
+    return status;
+}
+
+static ArgxcValueStatus boolOf(const char *line, bool *value)
+{
+    Argxc *argxc = createParser(line);
+    ArgxcValueStatus status = argxc ? argxcGetBool(argxc, "fast", value) : ARGX_VALUE_UNSET;
+
+    argxcDestroy(argxc);
+    return status;
+}
+
+int main(void)
+{
+    int64_t i64 = 0;
+    uint64_t u64 = 0;
+    double d = 0.0;
+    bool b = false;
+
+    // Signed integers: both spellings, the limits, and everything past them
+    CHECK(int64Of("--count=-42", &i64) == ARGX_VALUE_OK && i64 == -42);
+    CHECK(int64Of("--count 9223372036854775807", &i64) == ARGX_VALUE_OK && i64 == INT64_MAX);
+    CHECK(int64Of("--count -9223372036854775808", &i64) == ARGX_VALUE_OK && i64 == INT64_MIN);
+    CHECK(int64Of("--count 9223372036854775808", &i64) == ARGX_VALUE_INVALID);
+    CHECK(int64Of("--count 12x", &i64) == ARGX_VALUE_INVALID);
+    CHECK(int64Of("--count=", &i64) == ARGX_VALUE_INVALID);
+
+    // Unsigned integers reject a minus sign
+    CHECK(uint64Of("--size 18446744073709551615", &u64) == ARGX_VALUE_OK && u64 == UINT64_MAX);
+    CHECK(uint64Of("--size +7", &u64) == ARGX_VALUE_OK && u64 == 7);
+    CHECK(uint64Of("--size 18446744073709551616", &u64) == ARGX_VALUE_INVALID);
+    CHECK(uint64Of("--size -1", &u64) == ARGX_VALUE_INVALID);
+
+    // Doubles: '.' whatever the locale, exponents, and no overflow or underflow to zero
+    CHECK(doubleOf("--ratio 0.1", &d) == ARGX_VALUE_OK && d == 0.1);
+    CHECK(doubleOf("--ratio=-2.5e3", &d) == ARGX_VALUE_OK && d == -2500.0);
+    CHECK(doubleOf("--ratio inf", &d) == ARGX_VALUE_OK && isinf(d));
+    CHECK(doubleOf("--ratio 0", &d) == ARGX_VALUE_OK && d == 0.0);
+    CHECK(doubleOf("--ratio 1e309", &d) == ARGX_VALUE_INVALID);
+    CHECK(doubleOf("--ratio 1e-400", &d) == ARGX_VALUE_INVALID);
+    CHECK(doubleOf("--ratio 1,5", &d) == ARGX_VALUE_INVALID);
+
+    // Exactly halfway between 1 and the next double rounds to even, unless a digit far past
+    // the significant ones tips it up
+    const char *halfway = "1.00000000000000011102230246251565404236316680908203125";
+    size_t halfwayLen = strlen(halfway);
+    char *line = malloc(halfwayLen + 1000);
+    CHECK(line != NULL);
+
+    if (line)
+	{
+        snprintf(line, halfwayLen + 1000, "--ratio %s", halfway);
+        CHECK(doubleOf(line, &d) == ARGX_VALUE_OK && d == 1.0);
+
+        size_t len = strlen(line);
+        memset(line + len, '0', 900);
+        memcpy(line + len + 900, "1", 2);
+        CHECK(doubleOf(line, &d) == ARGX_VALUE_OK && d == 1.0 + DBL_EPSILON);
+
+        free(line);
+    }
+
+    // Booleans: alone, spelled out in any case, or rejected
+    CHECK(boolOf("--fast", &b) == ARGX_VALUE_OK && b);
+    CHECK(boolOf("--fast=No", &b) == ARGX_VALUE_OK && !b);
+    CHECK(boolOf("--fast=ON", &b) == ARGX_VALUE_OK && b);
+    CHECK(boolOf("--fast=maybe", &b) == ARGX_VALUE_INVALID);
+
+    // Strings, enums and the statuses without a value
+    Argxc *argxc = createParser("--name 'two words' --mode slow --count");
+    const char *name = NULL;
+    size_t mode = 0;
+
+    CHECK(argxcGetString(argxc, "name", &name) == ARGX_VALUE_OK && name && strcmp(name, "two words") == 0);
+    CHECK(argxcGetEnum(argxc, "mode", &mode) == ARGX_VALUE_OK && mode == 1);
+    CHECK(argxcGetInt64(argxc, "count", &i64) == ARGX_VALUE_MISSING);
+    CHECK(argxcGetUint64(argxc, "size", &u64) == ARGX_VALUE_UNSET);
+    CHECK(argxcGetDouble(argxc, "count", &d) == ARGX_VALUE_MISMATCH);
+    argxcDestroy(argxc);
+
+    argxc = createParser("--mode medium");
+    CHECK(argxcGetEnum(argxc, "mode", &mode) == ARGX_VALUE_INVALID);
+
+    // Validation reports the value and the option expecting it
+    size_t optionsCount = 0;
+    ArgxcOptions *options = argxcGetOptions(argxc, &optionsCount);
+    char *badValue[] = {"prog", "--size", "12", "--count=1.5"};
+    ArgxcDiagnostic diagnostic;
+
+    CHECK(!argxcDiagnoseArgs(options, optionsCount, badValue, 4, &diagnostic));
+    CHECK(diagnostic.kind == ARGX_DIAG_INVALID_VALUE);
+    CHECK(diagnostic.position == 3);
+    CHECK(diagnostic.parent && strcmp(diagnostic.parent, "count") == 0);
+
+    argxcDestroy(argxc);
+
+    return checkResult();
+}